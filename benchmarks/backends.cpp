@@ -0,0 +1,75 @@
+#include "benchmarks.h"
+#include "widget.h"
+#include <QElapsedTimer>
+
+namespace Benchmarks
+{
+//! Add backend comparison options
+void addBackendsOptions(QCommandLineParser &parser) {}
+
+//! Run backend comparison benchmark
+/*!
+ * Renders the same sequence of flat plots with both the Qt3D (offscreen) and raster backends, reporting the throughput of each.
+ * Shares the --images, --size, and --dpi options of the offscreen benchmark.
+ */
+int runBackends(const QCommandLineParser &parser)
+{
+    const auto nImages = parser.value("images").toInt();
+    const auto nSeries = parser.value("series").toInt();
+    const auto nPoints = parser.value("points").toInt();
+    const auto dpi = parser.value("dpi").toDouble();
+    auto sizeParts = parser.value("size").split('x');
+    if (sizeParts.size() != 2)
+    {
+        printf("Invalid image size '%s'.\n", qPrintable(parser.value("size")));
+        return 1;
+    }
+    const auto size = QSize(sizeParts[0].toInt(), sizeParts[1].toInt());
+
+    printf("Images / series / points : %i / %i / %i\n", nImages, nSeries, nPoints);
+    printf("Image size / dpi     : %i x %i / %g\n", size.width(), size.height(), dpi);
+
+    for (auto backend : {Mildred::MildredWidget::RenderBackend::Qt3D, Mildred::MildredWidget::RenderBackend::Raster})
+    {
+        Mildred::MildredWidget widget;
+        std::vector<Mildred::Data1DEntity *> entities;
+        for (auto i = 0; i < nSeries; ++i)
+            entities.push_back(widget.addData1D(QString("Series%1").arg(i).toStdString()));
+
+        QElapsedTimer timer;
+        qint64 firstImageTime = 0;
+        timer.start();
+        for (auto n = 0; n < nImages; ++n)
+        {
+            for (auto i = 0; i < nSeries; ++i)
+            {
+                auto [x, y] = sineData(nPoints, i * 0.1 + n * 0.01);
+                entities[i]->setData(x, y);
+            }
+            widget.showAllData();
+
+            auto image = backend == Mildred::MildredWidget::RenderBackend::Qt3D ? widget.renderImage(size, dpi)
+                                                                                 : widget.renderRasterImage(size, dpi);
+            if (image.isNull())
+            {
+                printf("Failed to render image %i.\n", n);
+                return 1;
+            }
+
+            if (n == 0)
+                firstImageTime = timer.nsecsElapsed();
+        }
+        auto totalTime = timer.nsecsElapsed();
+
+        printf("%-6s : first image %10.3f ms, ", backend == Mildred::MildredWidget::RenderBackend::Qt3D ? "Qt3D" : "Raster",
+               firstImageTime * 1.0e-6);
+        if (nImages > 1)
+            printf("%10.3f ms/image, %10.3f images/s\n", (totalTime - firstImageTime) * 1.0e-6 / (nImages - 1),
+                   (nImages - 1) / ((totalTime - firstImageTime) * 1.0e-9));
+        else
+            printf("\n");
+    }
+
+    return 0;
+}
+} // namespace Benchmarks
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QCommandLineParser>
+#include <QString>
+#include <utility>
+#include <vector>
+
+namespace Benchmarks
+{
+// Benchmark definition
+struct Benchmark
+{
+    // Name of the benchmark (as given on the command line)
+    QString name;
+    // Short description
+    QString description;
+    // Add benchmark-specific options to the parser
+    void (*addOptions)(QCommandLineParser &parser);
+    // Run the benchmark, returning the process exit code
+    int (*run)(const QCommandLineParser &parser);
+};
+
+// Time-to-first-frame
+void addFirstFrameOptions(QCommandLineParser &parser);
+int runFirstFrame(const QCommandLineParser &parser);
+// Offscreen rendering throughput
+void addOffscreenOptions(QCommandLineParser &parser);
+int runOffscreen(const QCommandLineParser &parser);
+// Qt3D vs raster backend comparison
+void addBackendsOptions(QCommandLineParser &parser);
+int runBackends(const QCommandLineParser &parser);
+// Parallel text loading throughput
+void addTextLoadOptions(QCommandLineParser &parser);
+int runTextLoad(const QCommandLineParser &parser);
+// Cache file writing and re-opening
+void addCacheOptions(QCommandLineParser &parser);
+int runCache(const QCommandLineParser &parser);
+
+// Return all available benchmarks
+const std::vector<Benchmark> &benchmarks();
+// Create test data for a single series of the specified number of points
+std::pair<std::vector<double>, std::vector<double>> sineData(int nPoints, double phase);
+} // namespace Benchmarks
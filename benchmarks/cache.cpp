@@ -0,0 +1,60 @@
+#include "benchmarks.h"
+#include "io/columncache.h"
+#include "widget.h"
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+namespace Benchmarks
+{
+//! Add cache options
+void addCacheOptions(QCommandLineParser &parser)
+{
+    parser.addOption({"cache-chunk", "Number of points per cache chunk (default = 65536)", "n", "65536"});
+}
+
+//! Run cache benchmark
+/*!
+ * Compares the time taken to set a single series of --points points from columns in memory (which requires a pass through all
+ * data) with that taken to re-open the same data from a cache file, and reports the time taken to write the cache.
+ */
+int runCache(const QCommandLineParser &parser)
+{
+    const auto nPoints = parser.value("points").toInt();
+    const auto chunkSize = parser.value("cache-chunk").toULongLong();
+
+    QTemporaryDir directory;
+    if (!directory.isValid())
+    {
+        printf("Failed to create temporary directory.\n");
+        return 1;
+    }
+    auto fileName = directory.filePath("data.mcache");
+
+    auto [x, y] = sineData(nPoints, 0.0);
+    Mildred::DataColumn xColumn(std::move(x)), yColumn(std::move(y));
+
+    Mildred::MildredWidget widget;
+    auto *entity = widget.addData1D("Cache");
+
+    QElapsedTimer timer;
+    timer.start();
+    entity->setData(xColumn, yColumn);
+    auto setTime = timer.nsecsElapsed();
+
+    timer.restart();
+    Mildred::ColumnCache::write(fileName, xColumn, yColumn, {}, chunkSize);
+    auto writeTime = timer.nsecsElapsed();
+
+    timer.restart();
+    auto cache = std::make_shared<const Mildred::ColumnCache>(fileName);
+    entity->setData(cache);
+    auto openTime = timer.nsecsElapsed();
+
+    printf("Points / levels      : %i / %i\n", nPoints, cache->nLevels());
+    printf("Set from columns     : %10.3f ms\n", setTime * 1.0e-6);
+    printf("Write cache          : %10.3f ms\n", writeTime * 1.0e-6);
+    printf("Open from cache      : %10.3f ms\n", openTime * 1.0e-6);
+
+    return 0;
+}
+} // namespace Benchmarks
@@ -0,0 +1,84 @@
+#include "benchmarks.h"
+#include "widget.h"
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+#include <memory>
+
+namespace Benchmarks
+{
+//! Add time-to-first-frame options
+void addFirstFrameOptions(QCommandLineParser &parser)
+{
+    parser.addOption({"widgets", "Number of widgets to create (default = 1)", "n", "1"});
+}
+
+//! Run time-to-first-frame benchmark
+/*!
+ * Measures the time taken from construction of the requested number of widgets to the point where every widget has rendered
+ * its first frame. Run twice with the program cache enabled to compare cold and warm startup. Note that the program cache is
+ * Qt's own shader disk cache (which the benchmark disables unless requested), so the comparison measures the benefit of Qt's
+ * default behaviour rather than any caching performed by Mildred itself.
+ */
+int runFirstFrame(const QCommandLineParser &parser)
+{
+    const auto nWidgets = parser.value("widgets").toInt();
+    const auto nSeries = parser.value("series").toInt();
+    const auto nPoints = parser.value("points").toInt();
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Create widgets and data
+    std::vector<std::unique_ptr<Mildred::MildredWidget>> widgets;
+    for (auto n = 0; n < nWidgets; ++n)
+    {
+        auto &widget = widgets.emplace_back(std::make_unique<Mildred::MildredWidget>());
+        widget->resize(640, 480);
+        for (auto i = 0; i < nSeries; ++i)
+        {
+            auto [x, y] = sineData(nPoints, i * 0.1);
+            widget->addData1D(QString("Series%1").arg(i).toStdString())->setData(x, y);
+        }
+        widget->showAllData();
+        widget->show();
+    }
+    auto constructionTime = timer.nsecsElapsed();
+
+    // Request a frame from each widget and wait for all to complete
+    QEventLoop loop;
+    auto nRemaining = nWidgets;
+    std::vector<std::unique_ptr<Qt3DRender::QRenderCaptureReply>> replies;
+    for (auto &widget : widgets)
+    {
+        auto &reply = replies.emplace_back(widget->captureFrame());
+        if (!reply)
+        {
+            printf("Widget has no view to capture.\n");
+            return 1;
+        }
+        QObject::connect(reply.get(), &Qt3DRender::QRenderCaptureReply::completed, [&]() {
+            if (--nRemaining == 0)
+                loop.quit();
+        });
+    }
+    QTimer::singleShot(60000, &loop, &QEventLoop::quit);
+    loop.exec();
+    auto firstFrameTime = timer.nsecsElapsed();
+
+    if (nRemaining != 0)
+    {
+        printf("Timed out waiting for %i widget(s) to render.\n", nRemaining);
+        return 1;
+    }
+
+    printf("Program binary cache : %s\n", Mildred::MildredWidget::isProgramBinaryCacheEnabled()
+                                               ? "enabled (Qt shader disk cache, on by default in applications)"
+                                               : "disabled (Qt shader disk cache turned off for this run)");
+    printf("Widgets / series / points : %i / %i / %i\n", nWidgets, nSeries, nPoints);
+    printf("Construction time    : %10.3f ms\n", constructionTime * 1.0e-6);
+    printf("Time to first frame  : %10.3f ms\n", firstFrameTime * 1.0e-6);
+
+    return 0;
+}
+} // namespace Benchmarks
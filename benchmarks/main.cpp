@@ -0,0 +1,79 @@
+#include "benchmarks.h"
+#include "widget.h"
+#include <QApplication>
+#include <algorithm>
+#include <cmath>
+
+namespace Benchmarks
+{
+// Return all available benchmarks
+const std::vector<Benchmark> &benchmarks()
+{
+    static std::vector<Benchmark> available = {
+        {"first-frame", "Time from widget construction to the first rendered frame", addFirstFrameOptions, runFirstFrame},
+        {"offscreen", "Offscreen image rendering throughput", addOffscreenOptions, runOffscreen},
+        {"backends", "Flat plot throughput of the Qt3D and raster backends", addBackendsOptions, runBackends},
+        {"text-load", "Parallel text file loading throughput", addTextLoadOptions, runTextLoad},
+        {"cache", "Cache file write and re-open times", addCacheOptions, runCache}};
+    return available;
+}
+
+// Create test data for a single series of the specified number of points
+std::pair<std::vector<double>, std::vector<double>> sineData(int nPoints, double phase)
+{
+    std::vector<double> x(nPoints), y(nPoints);
+    for (auto n = 0; n < nPoints; ++n)
+    {
+        x[n] = n * 0.01;
+        y[n] = 5.0 + sin(x[n] + phase);
+    }
+    return {x, y};
+}
+} // namespace Benchmarks
+
+int main(int argc, char *argv[])
+{
+    // Parse options before the application is created, since some (e.g. the program cache) must be set beforehand
+    QStringList arguments;
+    for (auto n = 0; n < argc; ++n)
+        arguments << QString::fromLocal8Bit(argv[n]);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Mildred benchmark suite");
+    parser.addHelpOption();
+    parser.addPositionalArgument("benchmark", "Benchmark to run");
+    QCommandLineOption programCacheOption("program-cache",
+                                          "Enable Qt's on-disk shader cache (disabled otherwise), stored in <dir>", "dir");
+    parser.addOption(programCacheOption);
+    parser.addOption({"series", "Number of data series per plot (default = 10)", "n", "10"});
+    parser.addOption({"points", "Number of points per data series (default = 1000)", "n", "1000"});
+    for (auto &benchmark : Benchmarks::benchmarks())
+        benchmark.addOptions(parser);
+    parser.parse(arguments);
+
+    if (parser.isSet(programCacheOption))
+        Mildred::MildredWidget::enableProgramBinaryCache(parser.value(programCacheOption));
+    else
+        QCoreApplication::setAttribute(Qt::AA_DisableShaderDiskCache, true);
+
+    QApplication app(argc, argv);
+
+    if (parser.isSet("help") || parser.positionalArguments().isEmpty())
+    {
+        printf("%s\nAvailable benchmarks:\n", qPrintable(parser.helpText()));
+        for (auto &benchmark : Benchmarks::benchmarks())
+            printf("  %-20s %s\n", qPrintable(benchmark.name), qPrintable(benchmark.description));
+        return 0;
+    }
+
+    auto name = parser.positionalArguments().first();
+    auto it = std::find_if(Benchmarks::benchmarks().begin(), Benchmarks::benchmarks().end(),
+                           [name](const auto &benchmark) { return benchmark.name == name; });
+    if (it == Benchmarks::benchmarks().end())
+    {
+        printf("Unrecognised benchmark '%s'.\n", qPrintable(name));
+        return 1;
+    }
+
+    return it->run(parser);
+}
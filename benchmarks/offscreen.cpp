@@ -0,0 +1,90 @@
+#include "benchmarks.h"
+#include "widget.h"
+#include <QElapsedTimer>
+
+namespace Benchmarks
+{
+//! Add offscreen rendering options
+void addOffscreenOptions(QCommandLineParser &parser)
+{
+    parser.addOption({"images", "Number of images to render (default = 100)", "n", "100"});
+    parser.addOption({"size", "Image size in pixels (default = 800x600)", "WxH", "800x600"});
+    parser.addOption({"dpi", "Image resolution (default = 96)", "dpi", "96"});
+    parser.addOption({"save", "Save the last rendered image to <file>", "file"});
+    parser.addOption({"line-mode", "Method used to draw wide lines - 'geometry' or 'instanced' (default = geometry)", "mode",
+                      "geometry"});
+    parser.addOption({"3d", "Render a 3D rather than a flat view"});
+}
+
+//! Run offscreen rendering benchmark
+/*!
+ * Measures the rate at which a single offscreen widget can produce images, updating the data for every image. The widget (and
+ * its aspect engine) is reused for all images. Run with QT_QPA_PLATFORM=offscreen on machines without a display.
+ */
+int runOffscreen(const QCommandLineParser &parser)
+{
+    const auto nImages = parser.value("images").toInt();
+    const auto nSeries = parser.value("series").toInt();
+    const auto nPoints = parser.value("points").toInt();
+    const auto dpi = parser.value("dpi").toDouble();
+    auto sizeParts = parser.value("size").split('x');
+    if (sizeParts.size() != 2)
+    {
+        printf("Invalid image size '%s'.\n", qPrintable(parser.value("size")));
+        return 1;
+    }
+    const auto size = QSize(sizeParts[0].toInt(), sizeParts[1].toInt());
+    const auto lineMode = parser.value("line-mode");
+    if (lineMode != "geometry" && lineMode != "instanced")
+    {
+        printf("Invalid line mode '%s'.\n", qPrintable(lineMode));
+        return 1;
+    }
+
+    Mildred::MildredWidget widget;
+    widget.setLineRenderMode(lineMode == "instanced" ? Mildred::MildredWidget::LineRenderMode::InstancedQuads
+                                                     : Mildred::MildredWidget::LineRenderMode::GeometryShader);
+    widget.setFlatView(!parser.isSet("3d"));
+    std::vector<Mildred::Data1DEntity *> entities;
+    for (auto i = 0; i < nSeries; ++i)
+        entities.push_back(widget.addData1D(QString("Series%1").arg(i).toStdString()));
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 firstImageTime = 0;
+    QImage image;
+    for (auto n = 0; n < nImages; ++n)
+    {
+        for (auto i = 0; i < nSeries; ++i)
+        {
+            auto [x, y] = sineData(nPoints, i * 0.1 + n * 0.01);
+            entities[i]->setData(x, y);
+        }
+        widget.showAllData();
+
+        image = widget.renderImage(size, dpi);
+        if (image.isNull())
+        {
+            printf("Failed to render image %i.\n", n);
+            return 1;
+        }
+
+        if (n == 0)
+            firstImageTime = timer.nsecsElapsed();
+    }
+    auto totalTime = timer.nsecsElapsed();
+
+    if (parser.isSet("save"))
+        image.save(parser.value("save"));
+
+    printf("Images / series / points : %i / %i / %i\n", nImages, nSeries, nPoints);
+    printf("Image size / dpi     : %i x %i / %g\n", size.width(), size.height(), dpi);
+    printf("View / line mode     : %s / %s\n", parser.isSet("3d") ? "3D" : "flat", qPrintable(lineMode));
+    printf("First image          : %10.3f ms\n", firstImageTime * 1.0e-6);
+    printf("Total time           : %10.3f ms\n", totalTime * 1.0e-6);
+    if (nImages > 1)
+        printf("Throughput           : %10.3f images/s\n", (nImages - 1) / ((totalTime - firstImageTime) * 1.0e-9));
+
+    return 0;
+}
+} // namespace Benchmarks
@@ -0,0 +1,76 @@
+#include "benchmarks.h"
+#include "io/textloader.h"
+#include "widget.h"
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTemporaryFile>
+
+namespace Benchmarks
+{
+//! Add text loading options
+void addTextLoadOptions(QCommandLineParser &parser)
+{
+    parser.addOption({"file", "Load <file> rather than generated data (of --points points)", "file"});
+    parser.addOption({"threads", "Number of parser threads (default = 0, all available)", "n", "0"});
+    parser.addOption({"chunk-size", "Target chunk size in MB (default = 4)", "MB", "4"});
+}
+
+//! Run text loading benchmark
+/*!
+ * Measures the rate at which a delimited text file is parsed and appended to a data entity, and the time until the first data
+ * are delivered. Unless a file is given, a two-column file of --points points is generated first.
+ */
+int runTextLoad(const QCommandLineParser &parser)
+{
+    const auto nThreads = parser.value("threads").toInt();
+    const auto chunkSize = parser.value("chunk-size").toDouble();
+
+    // Generate test data if required
+    QTemporaryFile temporaryFile;
+    auto fileName = parser.value("file");
+    if (fileName.isEmpty())
+    {
+        if (!temporaryFile.open())
+        {
+            printf("Failed to create temporary file.\n");
+            return 1;
+        }
+        auto [x, y] = sineData(parser.value("points").toInt(), 0.0);
+        for (auto n = 0; n < int(x.size()); ++n)
+            temporaryFile.write(QByteArray::number(x[n], 'g', 17) + ' ' + QByteArray::number(y[n], 'g', 17) + '\n');
+        temporaryFile.close();
+        fileName = temporaryFile.fileName();
+    }
+
+    Mildred::MildredWidget widget;
+    auto *entity = widget.addData1D("Text");
+
+    Mildred::TextLoader loader(fileName);
+    loader.setThreadCount(nThreads);
+    loader.setChunkSize(std::size_t(chunkSize * 1024 * 1024));
+    QElapsedTimer timer;
+    qint64 firstDataTime = 0;
+    QObject::connect(&loader, &Mildred::TextLoader::chunkLoaded,
+                     [&](Mildred::DataColumn x, Mildred::DataColumn values, std::optional<Mildred::DataColumn> errors) {
+                         if (entity->x().empty())
+                             firstDataTime = timer.nsecsElapsed();
+                         entity->appendData(std::move(x), std::move(values), std::move(errors));
+                     });
+
+    QEventLoop loop;
+    QObject::connect(&loader, &Mildred::TextLoader::finished, &loop, &QEventLoop::quit);
+    timer.start();
+    loader.start();
+    if (!loader.isFinished())
+        loop.exec();
+    auto totalTime = timer.nsecsElapsed();
+
+    printf("File size            : %10.3f MB\n", loader.nBytesDelivered() * 1.0e-6);
+    printf("Points / skipped     : %zu / %i\n", entity->x().size(), loader.nSkippedLines());
+    printf("First data           : %10.3f ms\n", firstDataTime * 1.0e-6);
+    printf("Total time           : %10.3f ms\n", totalTime * 1.0e-6);
+    printf("Throughput           : %10.3f MB/s\n", loader.throughput());
+
+    return 0;
+}
+} // namespace Benchmarks
@@ -27,6 +27,9 @@ MainWindow::MainWindow() : QMainWindow()
     displayGroup_ = ui_.TestingWidget->addDisplayGroup();
     displayGroup_->setSingleColour({255, 0, 200, 255});
 
+    // All datasets share the same x axis values
+    Mildred::DataColumn xColumn(xValues);
+
     // Create the datasets
     for (auto n = 0; n < nDataSets; ++n)
     {
@@ -40,7 +43,7 @@ MainWindow::MainWindow() : QMainWindow()
 
         // Create a renderable and add it to the group
         auto *renderable = ui_.TestingWidget->addData1D(std::string("Sines") + std::to_string(n));
-        renderable->setData(xValues, y);
+        renderable->setData(xColumn, y);
 
         renderable->colour().set({int(255 * dist(gen)), int(255 * dist(gen)), int(255 * dist(gen)), 255});
         displayGroup_->addTarget(renderable);
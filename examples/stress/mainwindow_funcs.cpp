@@ -24,6 +24,9 @@ MainWindow::MainWindow() : QMainWindow()
     std::mt19937 gen(rd());
     std::uniform_real_distribution<> dist(0.0, 1.0);
 
+    // All graphs share the same x axis values
+    Mildred::DataColumn xColumn(xValues);
+
     // Create a layout for out widgets
     auto *grid = new QGridLayout;
     for (auto row = 0; row < nRows; ++row)
@@ -42,7 +45,7 @@ MainWindow::MainWindow() : QMainWindow()
 
             // Add a renderable
             auto *renderable = graph->addData1D("Sines");
-            renderable->setData(xValues, y);
+            renderable->setData(xColumn, y);
 
             // Add the graph to the layout
             grid->addWidget(graph, row, column);
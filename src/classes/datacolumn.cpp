@@ -0,0 +1,231 @@
+#include "classes/datacolumn.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace Mildred;
+
+//! Construct a column taking ownership of the supplied values
+DataColumn::DataColumn(std::vector<double> values)
+    : DataColumn(std::make_shared<const std::vector<double>>(std::move(values)))
+{
+}
+
+//! Construct a single-precision column taking ownership of the supplied values
+DataColumn::DataColumn(std::vector<float> values)
+    : DataColumn(std::make_shared<const std::vector<float>>(std::move(values)))
+{
+}
+
+//! Construct a 64-bit integer column taking ownership of the supplied values
+DataColumn::DataColumn(std::vector<std::int64_t> values)
+    : DataColumn(std::make_shared<const std::vector<std::int64_t>>(std::move(values)))
+{
+}
+
+//! Construct a column referencing the supplied shared values
+DataColumn::DataColumn(std::shared_ptr<const std::vector<double>> values)
+{
+    if (!values)
+        return;
+
+    data_ = reinterpret_cast<const unsigned char *>(values->data());
+    size_ = values->size();
+    owner_ = std::move(values);
+}
+
+//! Construct a single-precision column referencing the supplied shared values
+DataColumn::DataColumn(std::shared_ptr<const std::vector<float>> values)
+{
+    if (!values)
+        return;
+
+    data_ = reinterpret_cast<const unsigned char *>(values->data());
+    size_ = values->size();
+    stride_ = sizeof(float);
+    type_ = ElementType::Float32;
+    owner_ = std::move(values);
+}
+
+//! Construct a 64-bit integer column referencing the supplied shared values
+DataColumn::DataColumn(std::shared_ptr<const std::vector<std::int64_t>> values)
+{
+    if (!values)
+        return;
+
+    data_ = reinterpret_cast<const unsigned char *>(values->data());
+    size_ = values->size();
+    stride_ = sizeof(std::int64_t);
+    type_ = ElementType::Int64;
+    owner_ = std::move(values);
+}
+
+//! Construct a column referencing external storage
+/*!
+ * Reference @param size values starting at @param data, which must remain valid for as long as @param owner (or any copy of it)
+ * is alive.
+ */
+DataColumn::DataColumn(const double *data, std::size_t size, std::shared_ptr<const void> owner)
+    : DataColumn(data, size, sizeof(double), std::move(owner))
+{
+}
+
+//! Construct a single-precision column referencing external storage
+DataColumn::DataColumn(const float *data, std::size_t size, std::shared_ptr<const void> owner)
+    : DataColumn(data, size, sizeof(float), std::move(owner), ElementType::Float32)
+{
+}
+
+//! Construct a 64-bit integer column referencing external storage
+DataColumn::DataColumn(const std::int64_t *data, std::size_t size, std::shared_ptr<const void> owner)
+    : DataColumn(data, size, sizeof(std::int64_t), std::move(owner), ElementType::Int64)
+{
+}
+
+//! Construct a strided column referencing external storage
+/*!
+ * Reference @param size values, the first located at @param data and each subsequent value @param byteStride bytes after the
+ * last, as is the case for a single field within an array of records. Values are stored as the specified @param type. The
+ * storage must remain valid for as long as @param owner (or any copy of it) is alive.
+ */
+DataColumn::DataColumn(const void *data, std::size_t size, std::size_t byteStride, std::shared_ptr<const void> owner,
+                       ElementType type)
+    : owner_(std::move(owner)), data_(static_cast<const unsigned char *>(data)), size_(size), stride_(byteStride), type_(type)
+{
+}
+
+//! Return token owning the underlying storage
+const std::shared_ptr<const void> &DataColumn::owner() const { return owner_; }
+
+//! Return a copy of the values
+std::vector<double> DataColumn::toVector() const
+{
+    if (isContiguous() && type_ == ElementType::Float64)
+    {
+        auto *first = reinterpret_cast<const double *>(data_);
+        return {first, first + size_};
+    }
+
+    return {begin(), end()};
+}
+
+//! Return a column containing the values stored with the specified element type
+/*!
+ * Return a new column holding a contiguous copy of the values stored as @param type, or this column if its values are already
+ * contiguous and of the requested type. Uniform columns require no storage and are always returned unchanged.
+ */
+DataColumn DataColumn::converted(ElementType type) const
+{
+    if (uniform_ || (isContiguous() && type_ == type))
+        return *this;
+
+    if (type == ElementType::Float32)
+    {
+        std::vector<float> values(size_);
+        for (std::size_t n = 0; n < size_; ++n)
+            values[n] = float((*this)[n]);
+        return DataColumn(std::move(values));
+    }
+    else if (type == ElementType::Int64)
+    {
+        std::vector<std::int64_t> values(size_);
+        for (std::size_t n = 0; n < size_; ++n)
+            values[n] = std::llround((*this)[n]);
+        return DataColumn(std::move(values));
+    }
+
+    return DataColumn(toVector());
+}
+
+//! Return a column sharing the same storage, but with the specified base value subtracted from Int64 values
+/*!
+ * Return a copy of the column whose Int64 values are returned relative to @param base. The storage is shared, not copied.
+ * Columns of other types are returned unchanged.
+ */
+DataColumn DataColumn::rebased(std::int64_t base) const
+{
+    auto column = *this;
+    if (type_ == ElementType::Int64)
+        column.base_ = base;
+    return column;
+}
+
+//! Return a column sharing the same storage, referencing the specified range of values
+/*!
+ * Return a column referencing @param count values starting at index @param first, clamped to the extent of this column. The
+ * storage is shared, not copied.
+ */
+DataColumn DataColumn::slice(std::size_t first, std::size_t count) const
+{
+    auto column = *this;
+    first = std::min(first, size_);
+    column.size_ = std::min(count, size_ - first);
+    if (uniform_)
+        column.start_ = start_ + double(first) * step_;
+    else if (data_)
+        column.data_ = data_ + first * stride_;
+    return column;
+}
+
+//! Return range of indices whose values lie within the specified limits
+/*!
+ * Return the half-open range of indices whose values lie within [@param minimum, @param maximum], assuming that values are in
+ * ascending order. For uniform columns this is calculated directly, and otherwise by binary search.
+ */
+std::pair<std::size_t, std::size_t> DataColumn::indexRange(double minimum, double maximum) const
+{
+    if (size_ == 0 || maximum < minimum)
+        return {0, 0};
+
+    if (uniform_)
+    {
+        if (step_ <= 0.0)
+            return {0, size_};
+        auto first = std::clamp(ceil((minimum - start_) / step_), 0.0, double(size_));
+        auto last = std::clamp(floor((maximum - start_) / step_) + 1.0, first, double(size_));
+        return {std::size_t(first), std::size_t(last)};
+    }
+
+    auto first = std::lower_bound(begin(), end(), minimum);
+    auto last = std::upper_bound(first, end(), maximum);
+    return {std::size_t(first - begin()), std::size_t(last - begin())};
+}
+
+//! Return a uniform column
+/*!
+ * Return a column of @param size values, the first equal to @param start and each subsequent value incremented by @param step.
+ * No storage is required.
+ */
+DataColumn DataColumn::uniform(double start, double step, std::size_t size)
+{
+    DataColumn column;
+    column.uniform_ = true;
+    column.start_ = start;
+    column.step_ = step;
+    column.size_ = size;
+    column.stride_ = 0;
+    return column;
+}
+
+//! Return a uniform column equivalent to the supplied values, if they are uniformly spaced
+/*!
+ * Test whether @param values are uniformly spaced, returning an equivalent uniform column if so. Each value must lie within
+ * @param tolerance (relative to the largest magnitude of the first value, last value, and step) of its uniform equivalent, so
+ * values containing NaNs or infinities are never considered uniform.
+ */
+std::optional<DataColumn> DataColumn::detectUniform(const std::vector<double> &values, double tolerance)
+{
+    if (values.size() < 3)
+        return std::nullopt;
+
+    auto start = values.front();
+    auto step = (values.back() - start) / double(values.size() - 1);
+    if (step == 0.0 || !std::isfinite(step))
+        return std::nullopt;
+
+    auto limit = tolerance * std::max({fabs(start), fabs(values.back()), fabs(step)});
+    for (std::size_t n = 1; n < values.size() - 1; ++n)
+        if (!(fabs(values[n] - (start + double(n) * step)) <= limit))
+            return std::nullopt;
+
+    return uniform(start, step, values.size());
+}
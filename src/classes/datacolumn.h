@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Mildred
+{
+//! DataColumn is a shared, immutable column of values
+/*!
+ * The @class DataColumn class provides read-only access to a column of values whose storage is owned elsewhere, and which may
+ * therefore be referenced by many data entities at once without being copied. Storage is kept alive by an owner token held by
+ * every column referencing it - this may be a shared std::vector<double>, or any other object managing the memory.
+ *
+ * Values may be stored in double (Float64) or single (Float32) precision - the latter halves the memory required for data
+ * which originates as floats, while all values are still returned as doubles so that extrema and tick calculations are
+ * unaffected. Values may also be stored as 64-bit integers (Int64) - for example, timestamps in nanoseconds - in which case a
+ * base value is subtracted (in integer arithmetic) before conversion to double, so that values close to the base retain full
+ * precision.
+ *
+ * Columns constructed from a std::vector take ownership of it, so moving a vector into a column costs nothing. Values
+ * need not be contiguous - a byte stride may be given so that a column reads a single field from an array of interleaved
+ * records, without the records being split or copied.
+ *
+ * Uniformly-spaced columns (such as the x values of regularly-sampled data) may instead be described by just a start value and
+ * step, requiring no storage at all.
+ */
+class DataColumn
+{
+    public:
+    // Storage type of values
+    enum class ElementType
+    {
+        Float64,
+        Float32,
+        Int64
+    };
+    DataColumn() = default;
+    DataColumn(std::vector<double> values);
+    DataColumn(std::vector<float> values);
+    DataColumn(std::vector<std::int64_t> values);
+    DataColumn(std::shared_ptr<const std::vector<double>> values);
+    DataColumn(std::shared_ptr<const std::vector<float>> values);
+    DataColumn(std::shared_ptr<const std::vector<std::int64_t>> values);
+    DataColumn(const double *data, std::size_t size, std::shared_ptr<const void> owner);
+    DataColumn(const float *data, std::size_t size, std::shared_ptr<const void> owner);
+    DataColumn(const std::int64_t *data, std::size_t size, std::shared_ptr<const void> owner);
+    DataColumn(const void *data, std::size_t size, std::size_t byteStride, std::shared_ptr<const void> owner,
+               ElementType type = ElementType::Float64);
+    ~DataColumn() = default;
+
+    private:
+    // Token keeping the underlying storage alive
+    std::shared_ptr<const void> owner_;
+    // Pointer to first value
+    const unsigned char *data_{nullptr};
+    // Number of values
+    std::size_t size_{0};
+    // Byte stride between successive values
+    std::size_t stride_{sizeof(double)};
+    // Storage type of values
+    ElementType type_{ElementType::Float64};
+    // Base value subtracted from Int64 values
+    std::int64_t base_{0};
+    // Whether the column is uniform, with values generated from the start value and step
+    bool uniform_{false};
+    // Start value and step for uniform columns
+    double start_{0.0}, step_{0.0};
+
+    public:
+    // Return number of values
+    std::size_t size() const { return size_; }
+    // Return whether the column is empty
+    bool empty() const { return size_ == 0; }
+    // Return value at the specified index
+    double operator[](std::size_t index) const
+    {
+        if (uniform_)
+            return start_ + double(index) * step_;
+
+        // Strided values may not be suitably aligned for direct access, so copy (which compiles to a plain load)
+        if (type_ == ElementType::Float32)
+        {
+            float value;
+            std::memcpy(&value, data_ + index * stride_, sizeof(float));
+            return value;
+        }
+        if (type_ == ElementType::Int64)
+        {
+            std::int64_t value;
+            std::memcpy(&value, data_ + index * stride_, sizeof(std::int64_t));
+            return double(value - base_);
+        }
+        double value;
+        std::memcpy(&value, data_ + index * stride_, sizeof(double));
+        return value;
+    }
+    // Return value at the specified index as a 64-bit integer, exactly as stored (without the base) for Int64 values
+    std::int64_t integerValue(std::size_t index) const
+    {
+        if (uniform_ || type_ != ElementType::Int64)
+            return std::llround((*this)[index]);
+
+        std::int64_t value;
+        std::memcpy(&value, data_ + index * stride_, sizeof(std::int64_t));
+        return value;
+    }
+    // Return storage type of values
+    ElementType elementType() const { return type_; }
+    // Return size in bytes of a single value of the specified element type
+    static std::size_t elementSize(ElementType type)
+    {
+        if (type == ElementType::Float32)
+            return sizeof(float);
+        return type == ElementType::Int64 ? sizeof(std::int64_t) : sizeof(double);
+    }
+    // Return size in bytes of a single stored value
+    std::size_t elementSize() const { return elementSize(type_); }
+    // Return base value subtracted from Int64 values
+    std::int64_t base() const { return base_; }
+    // Return byte stride between successive values
+    std::size_t byteStride() const { return stride_; }
+    // Return whether the values are contiguous in memory
+    bool isContiguous() const { return !uniform_ && stride_ == elementSize(); }
+    // Return whether the column is uniform
+    bool isUniform() const { return uniform_; }
+    // Return start value and step of uniform column
+    double uniformStart() const { return start_; }
+    double uniformStep() const { return step_; }
+    // Return range of indices whose values lie within the specified limits
+    std::pair<std::size_t, std::size_t> indexRange(double minimum, double maximum) const;
+    // Return token owning the underlying storage
+    const std::shared_ptr<const void> &owner() const;
+    // Return a copy of the values
+    std::vector<double> toVector() const;
+    // Return a column containing the values stored with the specified element type
+    DataColumn converted(ElementType type) const;
+    // Return a column sharing the same storage, but with the specified base value subtracted from Int64 values
+    DataColumn rebased(std::int64_t base) const;
+    // Return a column sharing the same storage, referencing the specified range of values
+    DataColumn slice(std::size_t first, std::size_t count) const;
+    // Return a uniform column
+    static DataColumn uniform(double start, double step, std::size_t size);
+    // Return a uniform column equivalent to the supplied values, if they are uniformly spaced
+    static std::optional<DataColumn> detectUniform(const std::vector<double> &values, double tolerance = 1.0e-12);
+    // Return a column referencing the specified (double, float, or 64-bit integer) member of an array of records
+    template <class Record, class T>
+    static DataColumn fromRecords(const Record *records, std::size_t size, T Record::*member, std::shared_ptr<const void> owner)
+    {
+        static_assert(std::is_same_v<T, double> || std::is_same_v<T, float> || std::is_same_v<T, std::int64_t>,
+                      "Record member must be a double, float, or 64-bit integer.");
+        if (!records || size == 0)
+            return {};
+        return {&(records->*member), size, sizeof(Record), std::move(owner),
+                std::is_same_v<T, float>          ? ElementType::Float32
+                : std::is_same_v<T, std::int64_t> ? ElementType::Int64
+                                                  : ElementType::Float64};
+    }
+
+    /*
+     * Iteration
+     */
+    public:
+    // Random-access iterator over column values
+    class const_iterator
+    {
+        public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = double;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = double;
+
+        const_iterator() = default;
+        const_iterator(const DataColumn *column, std::size_t index) : column_(column), index_(index) {}
+
+        private:
+        // Target column
+        const DataColumn *column_{nullptr};
+        // Current index
+        std::size_t index_{0};
+
+        public:
+        double operator*() const { return (*column_)[index_]; }
+        double operator[](difference_type n) const { return (*column_)[index_ + n]; }
+        const_iterator &operator++()
+        {
+            ++index_;
+            return *this;
+        }
+        const_iterator operator++(int) { return {column_, index_++}; }
+        const_iterator &operator--()
+        {
+            --index_;
+            return *this;
+        }
+        const_iterator operator--(int) { return {column_, index_--}; }
+        const_iterator &operator+=(difference_type n)
+        {
+            index_ += n;
+            return *this;
+        }
+        const_iterator &operator-=(difference_type n)
+        {
+            index_ -= n;
+            return *this;
+        }
+        const_iterator operator+(difference_type n) const { return {column_, index_ + n}; }
+        const_iterator operator-(difference_type n) const { return {column_, index_ - n}; }
+        difference_type operator-(const const_iterator &other) const { return difference_type(index_) - other.index_; }
+        bool operator==(const const_iterator &other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator &other) const { return index_ != other.index_; }
+        bool operator<(const const_iterator &other) const { return index_ < other.index_; }
+        bool operator>(const const_iterator &other) const { return index_ > other.index_; }
+        bool operator<=(const const_iterator &other) const { return index_ <= other.index_; }
+        bool operator>=(const const_iterator &other) const { return index_ >= other.index_; }
+    };
+
+    public:
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size_}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+};
+} // namespace Mildred
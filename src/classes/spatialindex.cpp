@@ -0,0 +1,353 @@
+#include "classes/spatialindex.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using namespace Mildred;
+
+//! Transform coordinate into index space
+double SpatialIndex::transform(double value, bool logarithmic) { return logarithmic ? log10(value) : value; }
+
+//! Return transformed x coordinate of the specified point
+double SpatialIndex::xAt(int index) const { return transform(x_[index], logX_); }
+
+//! Return transformed y coordinate of the specified point
+double SpatialIndex::yAt(int index) const { return transform(y_[index], logY_); }
+
+//! Call the supplied function for the index of every point which may lie within the specified (transformed) bounds
+/*!
+ * Visit all finite points which may lie within the bounds, skipping sorted blocks or grid cells which lie wholly outside. The
+ * supplied @param function must still test each point individually.
+ */
+template <class F> void SpatialIndex::forEachCandidate(double xMin, double yMin, double xMax, double yMax, F function) const
+{
+    if (sorted_)
+    {
+        auto first = int(std::lower_bound(x_.begin(), x_.end(), xMin,
+                                          [&](auto v, auto limit) { return transform(v, logX_) < limit; }) -
+                         x_.begin());
+        auto last = int(std::upper_bound(x_.begin(), x_.end(), xMax,
+                                         [&](auto limit, auto v) { return limit < transform(v, logX_); }) -
+                        x_.begin());
+        for (auto n = first; n < last;)
+        {
+            auto block = n / blockSize_;
+            auto blockEnd = std::min((block + 1) * blockSize_, last);
+            auto [blockYMin, blockYMax] = blockYRanges_[block];
+            if (blockYMax >= yMin && blockYMin <= yMax)
+                for (; n < blockEnd; ++n)
+                    if (std::isfinite(yAt(n)))
+                        function(n);
+            n = blockEnd;
+        }
+    }
+    else if (!cellOffsets_.empty())
+    {
+        auto iMin = std::clamp(int(floor((xMin - gridX_) / cellWidth_)), 0, nCellsX_ - 1);
+        auto iMax = std::clamp(int(floor((xMax - gridX_) / cellWidth_)), 0, nCellsX_ - 1);
+        auto jMin = std::clamp(int(floor((yMin - gridY_) / cellHeight_)), 0, nCellsY_ - 1);
+        auto jMax = std::clamp(int(floor((yMax - gridY_) / cellHeight_)), 0, nCellsY_ - 1);
+        for (auto j = jMin; j <= jMax; ++j)
+            for (auto i = iMin; i <= iMax; ++i)
+            {
+                auto cell = j * nCellsX_ + i;
+                for (auto k = cellOffsets_[cell]; k < cellOffsets_[cell + 1]; ++k)
+                    function(cellPoints_[k]);
+            }
+    }
+}
+
+//! Build block bounds for sorted points
+void SpatialIndex::buildBlocks()
+{
+    auto nBlocks = (int(x_.size()) + blockSize_ - 1) / blockSize_;
+    blockYRanges_.assign(nBlocks,
+                         {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()});
+    for (auto n = 0; n < int(y_.size()); ++n)
+    {
+        auto y = yAt(n);
+        if (!std::isfinite(y))
+            continue;
+        auto &[yMin, yMax] = blockYRanges_[n / blockSize_];
+        yMin = std::min(yMin, y);
+        yMax = std::max(yMax, y);
+    }
+}
+
+//! Build grid for unsorted points
+/*!
+ * Bin all finite points onto a uniform grid spanning their extent, containing (on average) four points per cell. Point indices
+ * are stored contiguously by cell.
+ */
+void SpatialIndex::buildGrid()
+{
+    // Determine extent of finite points
+    auto xMin = std::numeric_limits<double>::infinity(), xMax = -xMin, yMin = xMin, yMax = -xMin;
+    auto nFinite = 0;
+    for (auto n = 0; n < int(x_.size()); ++n)
+    {
+        auto x = xAt(n), y = yAt(n);
+        if (!std::isfinite(x) || !std::isfinite(y))
+            continue;
+        xMin = std::min(xMin, x);
+        xMax = std::max(xMax, x);
+        yMin = std::min(yMin, y);
+        yMax = std::max(yMax, y);
+        ++nFinite;
+    }
+
+    if (nFinite == 0)
+    {
+        nCellsX_ = 0;
+        nCellsY_ = 0;
+        cellOffsets_.clear();
+        cellPoints_.clear();
+        return;
+    }
+
+    // Set up grid
+    nCellsX_ = std::max(1, int(ceil(sqrt(nFinite / 4.0))));
+    nCellsY_ = nCellsX_;
+    gridX_ = xMin;
+    gridY_ = yMin;
+    cellWidth_ = xMax > xMin ? (xMax - xMin) / nCellsX_ : 1.0;
+    cellHeight_ = yMax > yMin ? (yMax - yMin) / nCellsY_ : 1.0;
+
+    // Return cell containing the point, or -1 if it is not finite
+    auto cellIndex = [&](int n) {
+        auto x = xAt(n), y = yAt(n);
+        if (!std::isfinite(x) || !std::isfinite(y))
+            return -1;
+        auto i = std::clamp(int((x - gridX_) / cellWidth_), 0, nCellsX_ - 1);
+        auto j = std::clamp(int((y - gridY_) / cellHeight_), 0, nCellsY_ - 1);
+        return j * nCellsX_ + i;
+    };
+
+    // Count points per cell, convert to offsets, and then fill
+    cellOffsets_.assign(nCellsX_ * nCellsY_ + 1, 0);
+    for (auto n = 0; n < int(x_.size()); ++n)
+        if (auto cell = cellIndex(n); cell != -1)
+            ++cellOffsets_[cell + 1];
+    std::partial_sum(cellOffsets_.begin(), cellOffsets_.end(), cellOffsets_.begin());
+    cellPoints_.resize(nFinite);
+    auto fill = cellOffsets_;
+    for (auto n = 0; n < int(x_.size()); ++n)
+        if (auto cell = cellIndex(n); cell != -1)
+            cellPoints_[fill[cell]++] = n;
+}
+
+//! Invalidate the index, so that it is rebuilt on next use
+void SpatialIndex::reset()
+{
+    valid_ = false;
+    x_ = DataColumn();
+    y_ = DataColumn();
+    blockYRanges_.clear();
+    cellOffsets_.clear();
+    cellPoints_.clear();
+}
+
+//! Return whether the index is valid for the specified axis transforms
+bool SpatialIndex::isValid(bool logX, bool logY) const { return valid_ && logX == logX_ && logY == logY_; }
+
+//! Build index for the supplied points
+/*!
+ * Build the index for the points defined by @param x and @param y, which must be of equal size, transforming either axis to
+ * logarithmic space if @param logX or @param logY are set. The columns are referenced rather than copied, so building the index
+ * requires no per-point storage for sorted data.
+ */
+void SpatialIndex::build(const DataColumn &x, const DataColumn &y, bool logX, bool logY)
+{
+    reset();
+
+    logX_ = logX;
+    logY_ = logY;
+    x_ = x;
+    y_ = y;
+
+    sorted_ = true;
+    for (auto n = 0, nPoints = int(x_.size()); n < nPoints && sorted_; ++n)
+        sorted_ = std::isfinite(xAt(n)) && (n == 0 || xAt(n - 1) <= xAt(n));
+    if (sorted_)
+        buildBlocks();
+    else
+        buildGrid();
+
+    valid_ = true;
+}
+
+//! Return index of, and scaled distance to, the nearest point to that specified
+/*!
+ * Find the nearest point to that specified by @param x and @param y (given in untransformed coordinates). Distances are
+ * measured after multiplying transformed coordinates by @param xScale and @param yScale respectively. Only points within
+ * @param maximumDistance are considered.
+ */
+std::optional<std::pair<int, double>> SpatialIndex::nearest(double x, double y, double xScale, double yScale,
+                                                            double maximumDistance) const
+{
+    x = transform(x, logX_);
+    y = transform(y, logY_);
+    if (!valid_ || !std::isfinite(x) || !std::isfinite(y))
+        return std::nullopt;
+
+    auto bestIndex = -1;
+    auto bestDistance = maximumDistance;
+    auto testPoint = [&](int n) {
+        auto distance = std::hypot((xAt(n) - x) * xScale, (yAt(n) - y) * yScale);
+        if (distance < bestDistance)
+        {
+            bestDistance = distance;
+            bestIndex = n;
+        }
+    };
+
+    if (sorted_)
+    {
+        if (x_.empty())
+            return std::nullopt;
+
+        // Search blocks outwards from that containing the specified x
+        auto nBlocks = int(blockYRanges_.size());
+        auto startIndex = int(std::lower_bound(x_.begin(), x_.end(), x,
+                                               [&](auto v, auto limit) { return transform(v, logX_) < limit; }) -
+                              x_.begin());
+        auto startBlock = std::min(startIndex / blockSize_, nBlocks - 1);
+        auto searchBlock = [&](int block) {
+            auto first = block * blockSize_, last = std::min(first + blockSize_, int(x_.size())) - 1;
+            auto [yMin, yMax] = blockYRanges_[block];
+            if (yMin > yMax)
+                return;
+            auto dx = std::max({0.0, xAt(first) - x, x - xAt(last)}) * xScale;
+            auto dy = std::max({0.0, yMin - y, y - yMax}) * yScale;
+            if (std::hypot(dx, dy) >= bestDistance)
+                return;
+            for (auto n = first; n <= last; ++n)
+                if (std::isfinite(yAt(n)))
+                    testPoint(n);
+        };
+        for (auto block = startBlock; block < nBlocks && (xAt(block * blockSize_) - x) * xScale < bestDistance; ++block)
+            searchBlock(block);
+        for (auto block = startBlock - 1;
+             block >= 0 && (x - xAt(std::min((block + 1) * blockSize_, int(x_.size())) - 1)) * xScale < bestDistance; --block)
+            searchBlock(block);
+    }
+    else
+    {
+        if (cellOffsets_.empty())
+            return std::nullopt;
+
+        // Search rings of cells outwards from that containing (or nearest to) the specified point
+        auto cx = std::clamp(int(floor((x - gridX_) / cellWidth_)), 0, nCellsX_ - 1);
+        auto cy = std::clamp(int(floor((y - gridY_) / cellHeight_)), 0, nCellsY_ - 1);
+        auto searchCell = [&](int i, int j) {
+            if (i < 0 || i >= nCellsX_ || j < 0 || j >= nCellsY_)
+                return;
+            auto cell = j * nCellsX_ + i;
+            for (auto k = cellOffsets_[cell]; k < cellOffsets_[cell + 1]; ++k)
+                testPoint(cellPoints_[k]);
+        };
+        auto ringSpacing = std::min(cellWidth_ * xScale, cellHeight_ * yScale);
+        for (auto r = 0; r <= std::max(nCellsX_, nCellsY_); ++r)
+        {
+            // Points in this and subsequent rings are at least (r - 1) cells away
+            if (r > 0 && (r - 1) * ringSpacing >= bestDistance)
+                break;
+
+            if (r == 0)
+            {
+                searchCell(cx, cy);
+                continue;
+            }
+            for (auto i = cx - r; i <= cx + r; ++i)
+            {
+                searchCell(i, cy - r);
+                searchCell(i, cy + r);
+            }
+            for (auto j = cy - r + 1; j <= cy + r - 1; ++j)
+            {
+                searchCell(cx - r, j);
+                searchCell(cx + r, j);
+            }
+        }
+    }
+
+    if (bestIndex == -1)
+        return std::nullopt;
+
+    return std::make_pair(bestIndex, bestDistance);
+}
+
+//! Return indices of all points within the specified rectangle
+/*!
+ * Return the indices, in ascending order, of all points lying within the rectangle bounded by @param xMin, @param yMin, @param
+ * xMax and @param yMax (given in untransformed coordinates).
+ */
+std::vector<int> SpatialIndex::withinRectangle(double xMin, double yMin, double xMax, double yMax) const
+{
+    std::vector<int> indices;
+    if (!valid_)
+        return indices;
+
+    xMin = transform(xMin, logX_);
+    xMax = transform(xMax, logX_);
+    yMin = transform(yMin, logY_);
+    yMax = transform(yMax, logY_);
+    if (xMin > xMax)
+        std::swap(xMin, xMax);
+    if (yMin > yMax)
+        std::swap(yMin, yMax);
+
+    forEachCandidate(xMin, yMin, xMax, yMax, [&](int n) {
+        auto x = xAt(n), y = yAt(n);
+        if (x >= xMin && x <= xMax && y >= yMin && y <= yMax)
+            indices.push_back(n);
+    });
+
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+//! Return indices of all points within the specified polygon
+/*!
+ * Return the indices, in ascending order, of all points lying within the closed @param polygon (given as untransformed
+ * vertices), determined with the even-odd rule.
+ */
+std::vector<int> SpatialIndex::withinPolygon(const std::vector<std::pair<double, double>> &polygon) const
+{
+    std::vector<int> indices;
+    if (!valid_ || polygon.size() < 3)
+        return indices;
+
+    // Transform polygon vertices and determine their bounds
+    std::vector<std::pair<double, double>> vertices(polygon.size());
+    std::transform(polygon.begin(), polygon.end(), vertices.begin(),
+                   [&](const auto &v) { return std::make_pair(transform(v.first, logX_), transform(v.second, logY_)); });
+    auto xMin = std::numeric_limits<double>::infinity(), xMax = -xMin, yMin = xMin, yMax = -xMin;
+    for (auto &[x, y] : vertices)
+    {
+        if (!std::isfinite(x) || !std::isfinite(y))
+            return indices;
+        xMin = std::min(xMin, x);
+        xMax = std::max(xMax, x);
+        yMin = std::min(yMin, y);
+        yMax = std::max(yMax, y);
+    }
+
+    forEachCandidate(xMin, yMin, xMax, yMax, [&](int n) {
+        auto x = xAt(n), y = yAt(n);
+        auto inside = false;
+        for (auto i = 0, j = int(vertices.size()) - 1; i < int(vertices.size()); j = i++)
+        {
+            auto &[xi, yi] = vertices[i];
+            auto &[xj, yj] = vertices[j];
+            if ((yi > y) != (yj > y) && x < (xj - xi) * (y - yi) / (yj - yi) + xi)
+                inside = !inside;
+        }
+        if (inside)
+            indices.push_back(n);
+    });
+
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
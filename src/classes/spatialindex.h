@@ -0,0 +1,75 @@
+#pragma once
+
+#include "classes/datacolumn.h"
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Mildred
+{
+//! SpatialIndex accelerates proximity queries on two-dimensional point data
+/*!
+ * The @class SpatialIndex class references a set of (x, y) points, optionally transformed to logarithmic space along either
+ * axis, and arranges them for fast nearest-point queries. Coordinates are read through the source columns (which share, rather
+ * than copy, their storage) so only block bounds and point indices are held by the index itself. Points sorted by x (the
+ * usual case for one-dimensional data) are divided into fixed-size blocks with known y bounds, found by binary search. Unsorted
+ * points are binned onto a uniform grid. Non-finite points (including non-positive values on logarithmic axes) are ignored.
+ *
+ * Region queries (rectangles and polygons) are given in untransformed coordinates, and polygon edges are taken to be straight
+ * lines in transformed space, matching their appearance on screen.
+ *
+ * Distances are measured in scaled (pixel) space, calculated from the supplied scale factors for each axis, such that queries
+ * remain valid when the axes are zoomed or translated without the index needing to be rebuilt.
+ */
+class SpatialIndex
+{
+    public:
+    SpatialIndex() = default;
+    ~SpatialIndex() = default;
+
+    private:
+    // Whether the index has been built, and the transforms it was built with
+    bool valid_{false}, logX_{false}, logY_{false};
+    // Source point coordinates
+    DataColumn x_, y_;
+    // Whether the points are sorted by x (and all x are finite)
+    bool sorted_{false};
+    // Block size (sorted points only)
+    static constexpr int blockSize_ = 64;
+    // Minimum and maximum y of each block (sorted points only)
+    std::vector<std::pair<double, double>> blockYRanges_;
+    // Grid origin, cell size, and dimensions (unsorted points only)
+    double gridX_{0.0}, gridY_{0.0}, cellWidth_{1.0}, cellHeight_{1.0};
+    int nCellsX_{0}, nCellsY_{0};
+    // Offsets of cells into the grid point index array, and the grid point indices (unsorted points only)
+    std::vector<int> cellOffsets_, cellPoints_;
+
+    private:
+    // Build block bounds for sorted points
+    void buildBlocks();
+    // Build grid for unsorted points
+    void buildGrid();
+    // Transform coordinate into index space
+    static double transform(double value, bool logarithmic);
+    // Return transformed coordinates of the specified point
+    double xAt(int index) const;
+    double yAt(int index) const;
+    // Call the supplied function for the index of every point which may lie within the specified (transformed) bounds
+    template <class F> void forEachCandidate(double xMin, double yMin, double xMax, double yMax, F function) const;
+
+    public:
+    // Invalidate the index, so that it is rebuilt on next use
+    void reset();
+    // Return whether the index is valid for the specified axis transforms
+    bool isValid(bool logX, bool logY) const;
+    // Build index for the supplied points
+    void build(const DataColumn &x, const DataColumn &y, bool logX, bool logY);
+    // Return index of, and scaled distance to, the nearest point to that specified
+    std::optional<std::pair<int, double>> nearest(double x, double y, double xScale, double yScale,
+                                                  double maximumDistance) const;
+    // Return indices of all points within the specified rectangle
+    std::vector<int> withinRectangle(double xMin, double yMin, double xMax, double yMax) const;
+    // Return indices of all points within the specified polygon
+    std::vector<int> withinPolygon(const std::vector<std::pair<double, double>> &polygon) const;
+};
+} // namespace Mildred
@@ -1,6 +1,8 @@
 #include "entities/axis.h"
 #include "classes/cuboid.h"
 #include "material.h"
+#include <QDateTime>
+#include <QTimeZone>
 #include <stdexcept>
 
 using namespace Mildred;
@@ -206,6 +208,127 @@ std::vector<std::pair<double, bool>> AxisEntity::generateLogarithmicTicks() cons
     return ticks;
 }
 
+//! Generate time ticks on calendar boundaries
+/*!
+ * Generate ticks for a time axis, choosing a major tick step from the natural calendar intervals (nanoseconds through to days)
+ * appropriate to the current range. Ticks are placed on multiples of the step in absolute (UTC) time, so that e.g. hourly
+ * ticks fall on the hour regardless of the time epoch. Calculations are performed in integer nanoseconds.
+ */
+std::vector<std::pair<double, bool>> AxisEntity::generateTimeTicks() const
+{
+    // Available major tick steps, and the number of sub-intervals for each
+    constexpr std::int64_t us = 1000, ms = 1000 * us, s = 1000 * ms, min = 60 * s, h = 60 * min, day = 24 * h;
+    static const std::vector<std::pair<std::int64_t, int>> steps = {
+        {1, 1},         {2, 2},         {5, 5},         {10, 5},         {20, 4},         {50, 5},          {100, 5},
+        {200, 4},       {500, 5},       {us, 5},        {2 * us, 4},     {5 * us, 5},     {10 * us, 5},     {20 * us, 4},
+        {50 * us, 5},   {100 * us, 5},  {200 * us, 4},  {500 * us, 5},   {ms, 5},         {2 * ms, 4},      {5 * ms, 5},
+        {10 * ms, 5},   {20 * ms, 4},   {50 * ms, 5},   {100 * ms, 5},   {200 * ms, 4},   {500 * ms, 5},    {s, 5},
+        {2 * s, 4},     {5 * s, 5},     {10 * s, 5},    {15 * s, 3},     {30 * s, 3},     {min, 4},         {2 * min, 4},
+        {5 * min, 5},   {10 * min, 5},  {15 * min, 3},  {30 * min, 3},   {h, 4},          {2 * h, 4},       {3 * h, 3},
+        {6 * h, 6},     {12 * h, 4},    {day, 4},       {2 * day, 2},    {5 * day, 5},    {10 * day, 5},    {20 * day, 4},
+        {50 * day, 5},  {100 * day, 5}, {200 * day, 4}, {500 * day, 5},  {1000 * day, 5}, {2000 * day, 4}, {5000 * day, 5}};
+    const auto maxTicks = 6;
+
+    // Choose the smallest step giving no more than the maximum number of labelled ticks
+    auto range = maximum_ - minimum_;
+    auto it = std::find_if(steps.begin(), steps.end(), [range](const auto &step) { return range / step.first <= maxTicks; });
+    if (it == steps.end() || range <= 0.0)
+        return {};
+    auto [step, nIntervals] = *it;
+    auto delta = step / nIntervals;
+    timeTickStep_ = step;
+
+    // Find the first sub-tick at or beyond the minimum, in absolute time
+    auto floorDiv = [](std::int64_t a, std::int64_t b) { return a / b - ((a % b != 0) && ((a < 0) != (b < 0))); };
+    auto first = timeEpoch_ + std::int64_t(std::ceil(minimum_));
+    auto last = timeEpoch_ + std::int64_t(std::floor(maximum_));
+    auto time = (floorDiv(first - 1, delta) + 1) * delta;
+
+    std::vector<std::pair<double, bool>> ticks;
+    for (; time <= last; time += delta)
+        ticks.emplace_back(double(time - timeEpoch_), floorDiv(time, step) * step == time);
+
+    return ticks;
+}
+
+//! Return label for the specified absolute tick time
+/*!
+ * Return the label for the tick at @param time (in nanoseconds since the Unix epoch). The label format depends on the current
+ * tick step, and is determined only when the step changes. Labels themselves are cached for the current step, so that panning
+ * (which changes the ticks but not the step) does not regenerate existing labels.
+ */
+const QString &AxisEntity::timeLabel(std::int64_t time) const
+{
+    constexpr std::int64_t s = 1000000000, min = 60 * s, day = 24 * 60 * min;
+
+    // Update format if the tick step has changed
+    if (timeTickStep_ != timeLabelStep_)
+    {
+        timeLabelStep_ = timeTickStep_;
+        timeLabels_.clear();
+        if (timeLabelStep_ >= day)
+            timeLabelFormat_ = "yyyy-MM-dd";
+        else if (timeLabelStep_ >= min)
+            timeLabelFormat_ = "HH:mm";
+        else
+            timeLabelFormat_ = "HH:mm:ss";
+
+        // Number of fractional digits is determined by the number of trailing zeros in the (sub-second) step
+        timeLabelFractionDigits_ = 0;
+        if (timeLabelStep_ > 0 && timeLabelStep_ < s)
+        {
+            timeLabelFractionDigits_ = 9;
+            for (auto step = timeLabelStep_; step % 10 == 0; step /= 10)
+                --timeLabelFractionDigits_;
+        }
+    }
+
+    auto it = timeLabels_.find(time);
+    if (it != timeLabels_.end())
+        return it->second;
+
+    // Keep the cache bounded if the view is panned over a long range
+    if (timeLabels_.size() > 1024)
+        timeLabels_.clear();
+
+    auto seconds = time / s - (time % s < 0 ? 1 : 0);
+    auto nanoseconds = time - seconds * s;
+    auto label = QDateTime::fromSecsSinceEpoch(seconds, QTimeZone::utc()).toString(timeLabelFormat_);
+    if (timeLabelFractionDigits_ > 0)
+    {
+        auto fraction = nanoseconds;
+        for (auto n = timeLabelFractionDigits_; n < 9; ++n)
+            fraction /= 10;
+        label += QString(".%1").arg(fraction, timeLabelFractionDigits_, 10, QChar('0'));
+    }
+
+    return timeLabels_.emplace(time, label).first->second;
+}
+
+//! Return ticks for the current axis range, flagging those which are labelled
+/*!
+ * Generate ticks appropriate to the current axis range and type. The returned vector consists of pairs of double and bool
+ * specifying the numerical value of the tick and whether it is a full/value tick requiring a label (true) or is just a sub-tick
+ * (false).
+ */
+std::vector<std::pair<double, bool>> AxisEntity::ticks() const
+{
+    if (timeAxis_)
+        return generateTimeTicks();
+
+    if (logarithmic_)
+        return generateLogarithmicTicks();
+
+    // Calculate autoticks if requested
+    if (autoTicks_)
+    {
+        auto [tickStart, tickDelta] = calculateTickStartAndDelta();
+        return generateLinearTicks(tickStart, tickDelta);
+    }
+
+    return generateLinearTicks(0.0, 1.0);
+}
+
 // Return the minimum display value of the axis
 double AxisEntity::minimum() const { return minimum_; }
 
@@ -228,6 +351,7 @@ void AxisEntity::setLimits(double minValue, double maxValue)
     recreate();
 
     emit(rangeChanged());
+    emit(limitsChanged());
 }
 
 //! Return range of axis
@@ -241,7 +365,7 @@ double AxisEntity::range() const { return maximum_ - minimum_; }
  * Adjust the limits of the axis by the supplied @param delta. The @param delta is added to both the minimum and maximum values.
  * The overall range of the axis is not modified, unless the axis represents a logarithmic scale.
  *
- * Emits rangeChanged() if the axis style is logarithmic.
+ * Emits limitsChanged(), and rangeChanged() if the axis style is logarithmic.
  */
 void AxisEntity::shiftLimits(double delta)
 {
@@ -261,6 +385,8 @@ void AxisEntity::shiftLimits(double delta)
     }
 
     recreate();
+
+    emit(limitsChanged());
 }
 
 //! Shift the limits of the axis based on the supplied screen pixel delta
@@ -269,7 +395,7 @@ void AxisEntity::shiftLimits(double delta)
  * delta which is then added to both the minimum and maximum values. The overall range of the axis is not modified, unless the
  * axis represents a logarithmic scale.
  *
- * Emits rangeChanged() if the axis style is logarithmic.
+ * Emits limitsChanged(), and rangeChanged() if the axis style is logarithmic.
  */
 // Shift limits of axis using the specified pixel delta
 void AxisEntity::shiftLimitsByPixels(int pixelDelta)
@@ -298,6 +424,8 @@ void AxisEntity::shiftLimitsByPixels(int pixelDelta)
     }
 
     recreate();
+
+    emit(limitsChanged());
 }
 
 //! Return whether the axis is logarithmic
@@ -330,7 +458,7 @@ QString AxisEntity::titleText() const
  *
  * Once the new limit(s) are set, the axis entities are recreated.
  *
- * Emits rangeChanged().
+ * Emits rangeChanged() and limitsChanged().
  */
 void AxisEntity::setMinimum(double value)
 {
@@ -351,6 +479,7 @@ void AxisEntity::setMinimum(double value)
         minimum_ = value;
 
     emit(rangeChanged());
+    emit(limitsChanged());
 }
 
 //! Set axis maximum
@@ -360,7 +489,7 @@ void AxisEntity::setMinimum(double value)
  *
  * Once the new limit(s) are set, the axis entities are recreated.
  *
- * Emits rangeChanged().
+ * Emits rangeChanged() and limitsChanged().
  */
 void AxisEntity::setMaximum(double value)
 {
@@ -383,6 +512,7 @@ void AxisEntity::setMaximum(double value)
     recreate();
 
     emit(rangeChanged());
+    emit(limitsChanged());
 }
 
 //! Set whether the axis is logarithmic
@@ -392,7 +522,7 @@ void AxisEntity::setMaximum(double value)
  *
  * If the style of axis is changed, the axis entities are recreated.
  *
- * Emits rangeChanged().
+ * Emits rangeChanged() and limitsChanged().
  */
 void AxisEntity::setLogarithmic(bool b)
 {
@@ -416,6 +546,61 @@ void AxisEntity::setLogarithmic(bool b)
     recreate();
 
     emit(rangeChanged());
+    emit(limitsChanged());
+}
+
+//! Set whether the axis represents time
+/*!
+ * Set whether the axis represents time (true), in which case axis values are in nanoseconds relative to the time epoch, ticks
+ * are placed on calendar boundaries, and labels show the corresponding (UTC) time. A time axis is always linear.
+ *
+ * Emits rangeChanged().
+ */
+void AxisEntity::setTimeAxis(bool b)
+{
+    if (timeAxis_ == b)
+        return;
+
+    timeAxis_ = b;
+    logarithmic_ = false;
+
+    recreate();
+
+    emit(rangeChanged());
+}
+
+//! Return whether the axis represents time
+bool AxisEntity::isTimeAxis() const { return timeAxis_; }
+
+//! Set time epoch (nanoseconds since the Unix epoch)
+/*!
+ * Set the absolute time, in nanoseconds since the Unix epoch (UTC), corresponding to an axis value of zero on a time axis.
+ * Since axis values are doubles, choosing an epoch close to the data (e.g. the start of the day) preserves nanosecond
+ * resolution. Data supplied as 64-bit integer columns are rebased to the epoch in effect when the data are set.
+ */
+void AxisEntity::setTimeEpoch(std::int64_t epoch)
+{
+    if (timeEpoch_ == epoch)
+        return;
+
+    timeEpoch_ = epoch;
+
+    recreate();
+}
+
+//! Return time epoch (nanoseconds since the Unix epoch)
+std::int64_t AxisEntity::timeEpoch() const { return timeEpoch_; }
+
+//! Return label text for the specified tick value
+/*!
+ * Return the label text for the tick at @param value, which should have been generated by ticks().
+ */
+QString AxisEntity::tickLabel(double value) const
+{
+    if (timeAxis_)
+        return timeLabel(timeEpoch_ + std::int64_t(std::llround(value)));
+
+    return QString::number(value);
 }
 
 /*
@@ -475,6 +660,12 @@ void AxisEntity::setDirection(QVector3D v) { direction_ = v; }
 // Return explicit direction
 QVector3D AxisEntity::direction() const { return direction_; }
 
+//! Return tick direction
+QVector3D AxisEntity::tickDirection() const { return tickDirection_; }
+
+//! Return tick label anchor point
+MildredMetrics::AnchorPoint AxisEntity::labelAnchorPoint() const { return labelAnchorPoint_; }
+
 //! Get relevant scale from the supplied metrics
 /*!
  * Retrieve the relevant scale from the supplied @param metrics given the current axis type.
@@ -509,13 +700,33 @@ double AxisEntity::toGlobal(double axisValue) const
  */
 QVector3D AxisEntity::to3D(double axisValue) const { return direction_ * float(toGlobal(axisValue)); }
 
-//! Return scaled value point
-QVector3D AxisEntity::toScaled(double axisValue) const
+//! Return scale factor between (transformed) axis values and scaled units
+/*!
+ * Return the number of scaled (pixel) units per unit of axis value along the axis, or per decade if the axis is logarithmic.
+ */
+double AxisEntity::scaleFactor() const
 {
     if (logarithmic_)
-        return direction_ * log10(axisValue) * axisScale_ / (log10(maximum_) - log10(minimum_));
+        return axisScale_ / (log10(maximum_) - log10(minimum_));
     else
-        return direction_ * axisValue * axisScale_ / range();
+        return axisScale_ / range();
+}
+
+//! Return scaled value point
+QVector3D AxisEntity::toScaled(double axisValue) const
+{
+    return direction_ * (logarithmic_ ? log10(axisValue) : axisValue) * scaleFactor();
+}
+
+//! Return scaled value point relative to the specified origin
+/*!
+ * Return the scaled position of @param axisValue relative to that of @param origin. The difference is calculated in double
+ * precision before conversion, so remains accurate for large-magnitude values close to the origin.
+ */
+QVector3D AxisEntity::toScaled(double axisValue, double origin) const
+{
+    auto delta = logarithmic_ ? log10(axisValue) - log10(origin) : axisValue - origin;
+    return direction_ * float(delta * scaleFactor());
 }
 
 //! Return axis value from scaled point
@@ -550,7 +761,7 @@ Cuboid AxisEntity::createTickAndLabelEntities(const std::vector<std::pair<double
     auto nTicks = std::count_if(ticks.begin(), ticks.end(), [](const auto &t) { return t.second; });
 
     // Create any new text entities that we need
-    while (tickLabelEntities_.size() < nTicks)
+    while (geometryEnabled_ && tickLabelEntities_.size() < nTicks)
     {
         auto *entity = new TextEntity(this);
         entity->setFont(metrics_.axisTickLabelFont());
@@ -570,24 +781,30 @@ Cuboid AxisEntity::createTickAndLabelEntities(const std::vector<std::pair<double
         if (label)
         {
             // Create tick mark
-            ticksEntity_->addVertices({axisPos, axisPos + tickPos});
+            if (geometryEnabled_)
+                ticksEntity_->addVertices({axisPos, axisPos + tickPos});
             boundingCuboid.expand({axisPos, axisPos + tickPos});
 
             // Set label details
-            (*tickLabelEntity)->setEnabled(true);
-            (*tickLabelEntity)->setText(QString::number(v));
-            (*tickLabelEntity)
-                ->setAnchorPosition(axisPos + tickDirection_ * (metrics_.tickPixelSize() + metrics_.tickLabelPixelGap()));
+            auto text = tickLabel(v);
+            if (geometryEnabled_)
+            {
+                (*tickLabelEntity)->setEnabled(true);
+                (*tickLabelEntity)->setText(text);
+                (*tickLabelEntity)
+                    ->setAnchorPosition(axisPos + tickDirection_ * (metrics_.tickPixelSize() + metrics_.tickLabelPixelGap()));
+                ++tickLabelEntity;
+            }
             boundingCuboid.expand(TextEntity::boundingCuboid(
-                                      metrics_.axisTickLabelFont(), QString::number(v),
+                                      metrics_.axisTickLabelFont(), text,
                                       {axisPos + tickDirection_ * (metrics_.tickPixelSize() + metrics_.tickLabelPixelGap())},
                                       labelAnchorPoint_)
                                       .first);
-            ++tickLabelEntity;
         }
         else
         {
-            subTicksEntity_->addVertices({axisPos, {axisPos + tickPos * 0.5}});
+            if (geometryEnabled_)
+                subTicksEntity_->addVertices({axisPos, {axisPos + tickPos * 0.5}});
             boundingCuboid.expand({axisPos, axisPos + tickPos * 0.5});
         }
     }
@@ -614,36 +831,23 @@ void AxisEntity::recreate()
     subTicksEntity_->clear();
 
     // Plot basic axis line
-    axisBarEntity_->addVertices({{0.0, 0.0, 0.0}, direction_ * float(axisScale_)});
+    if (geometryEnabled_)
+        axisBarEntity_->addVertices({{0.0, 0.0, 0.0}, direction_ * float(axisScale_)});
     axisBarEntity_->setBasicIndices();
     axisBarEntity_->finalise();
 
     // Generate axis ticks
-    std::vector<std::pair<double, bool>> ticks;
-    if (logarithmic_)
-        ticks = generateLogarithmicTicks();
-    else
-    {
-        // Calculate autoticks if requested
-        if (autoTicks_)
-        {
-            auto [tickStart, tickDelta] = calculateTickStartAndDelta();
-            ticks = generateLinearTicks(tickStart, tickDelta);
-        }
-        else
-            ticks = generateLinearTicks(0.0, 1.0);
-    }
-    auto tickLabelBounds = createTickAndLabelEntities(ticks);
+    auto tickLabelBounds = createTickAndLabelEntities(ticks());
 
     // Axis title
-    if (!axisTitleEntity_->text().isEmpty())
+    titleAnchorPosition_ = direction_ * metrics_.displayVolumeExtent()[axisDirectionIndex_] * 0.5 +
+                           tickDirection_ * (tickLabelBounds.extents()[tickDirectionIndex_] + metrics_.tickLabelPixelGap());
+    if (geometryEnabled_ && !axisTitleEntity_->text().isEmpty())
     {
         axisTitleEntity_->setEnabled(true);
         axisTitleEntity_->setFont(metrics_.axisTitleFont());
         axisTitleEntity_->setAnchorPoint(labelAnchorPoint_);
-        axisTitleEntity_->setAnchorPosition(
-            direction_ * metrics_.displayVolumeExtent()[axisDirectionIndex_] * 0.5 +
-            tickDirection_ * (tickLabelBounds.extents()[tickDirectionIndex_] + metrics_.tickLabelPixelGap()));
+        axisTitleEntity_->setAnchorPosition(titleAnchorPosition_);
     }
     else
         axisTitleEntity_->setEnabled(false);
@@ -652,8 +856,18 @@ void AxisEntity::recreate()
     ticksEntity_->finalise();
     subTicksEntity_->setBasicIndices();
     subTicksEntity_->finalise();
+
+    emit(recreated());
 }
 
+//! Set whether renderable geometry is created for the axis
+/*!
+ * Set whether the bar, ticks, labels, and title of the axis are created as renderable entities when the axis is recreated. When
+ * @param enabled is false (e.g. when the axes are painted by other means) only the layout of the axis is calculated. The axis
+ * is not recreated by this function.
+ */
+void AxisEntity::setGeometryEnabled(bool enabled) { geometryEnabled_ = enabled; }
+
 //! Return bounding cuboid for axis given its current settings and supplied metrics
 /*!
  * Return the bounding cuboid for the axis given the supplied @param metrics. The returned cuboid represents the limiting 3D
@@ -661,30 +875,15 @@ void AxisEntity::recreate()
  */
 Cuboid AxisEntity::boundingCuboid(const MildredMetrics &metrics) const
 {
-    // Generate axis ticks
-    std::vector<std::pair<double, bool>> ticks;
-    if (logarithmic_)
-        ticks = generateLogarithmicTicks();
-    else
-    {
-        // Calculate autoticks if requested
-        if (autoTicks_)
-        {
-            auto [tickStart, tickDelta] = calculateTickStartAndDelta();
-            ticks = generateLinearTicks(tickStart, tickDelta);
-        }
-        else
-            ticks = generateLinearTicks(0.0, 10.0);
-    }
-
     // Determine bounding cuboid for the axis
     Cuboid cuboid;
     // -- Axis bar
     auto axisScale = getAxisScale(metrics);
     cuboid.expand({{0.0, 0.0, 0.0}, direction_ * float(axisScale)});
 
-    // -- Ticks
-    for (auto &&[v, label] : ticks)
+    // -- Ticks (bounds for fixed linear ticks have always been estimated with a tick delta of 10)
+    auto fixedLinearTicks = !timeAxis_ && !logarithmic_ && !autoTicks_;
+    for (auto &&[v, label] : fixedLinearTicks ? generateLinearTicks(0.0, 10.0) : ticks())
     {
         auto axisPos = to3D(v);
 
@@ -695,7 +894,7 @@ Cuboid AxisEntity::boundingCuboid(const MildredMetrics &metrics) const
 
             // Label
             cuboid.expand(
-                TextEntity::boundingCuboid(metrics.axisTickLabelFont(), QString::number(v),
+                TextEntity::boundingCuboid(metrics.axisTickLabelFont(), tickLabel(v),
                                            axisPos + tickDirection_ * (metrics_.tickPixelSize() + metrics.tickLabelPixelGap()),
                                            labelAnchorPoint_)
                     .first);
@@ -715,6 +914,12 @@ Cuboid AxisEntity::boundingCuboid(const MildredMetrics &metrics) const
     return cuboid;
 }
 
+//! Return anchor position of axis title
+/*!
+ * Return the anchor position of the axis title, relative to the axis origin, as determined when the axis was last recreated.
+ */
+QVector3D AxisEntity::titleAnchorPosition() const { return titleAnchorPosition_; }
+
 /*
  * Components
  */
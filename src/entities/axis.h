@@ -6,6 +6,8 @@
 #include "entities/text.h"
 #include <Qt3DCore/QTransform>
 #include <Qt3DExtras/QDiffuseSpecularMaterial>
+#include <cstdint>
+#include <unordered_map>
 
 namespace Mildred
 {
@@ -54,6 +56,20 @@ class AxisEntity : public Qt3DCore::QEntity
     int nSubTicks_{4};
     // Whether to determine major ticks automatically
     bool autoTicks_{true};
+    // Whether the axis represents time, with axis values in nanoseconds relative to the time epoch
+    bool timeAxis_{false};
+    // Time epoch, in nanoseconds since the Unix epoch (UTC), corresponding to an axis value of zero
+    std::int64_t timeEpoch_{0};
+    // Tick step (in nanoseconds) for which the current time labels were formatted
+    mutable std::int64_t timeLabelStep_{0};
+    // Format for time labels at the current tick step
+    mutable QString timeLabelFormat_;
+    // Number of fractional second digits in time labels at the current tick step
+    mutable int timeLabelFractionDigits_{0};
+    // Time labels at the current tick step, keyed by tick time
+    mutable std::unordered_map<std::int64_t, QString> timeLabels_;
+    // Current time tick step (in nanoseconds), determined on tick generation
+    mutable std::int64_t timeTickStep_{0};
 
     private:
     // Calculate suitable tick start and delta
@@ -62,8 +78,14 @@ class AxisEntity : public Qt3DCore::QEntity
     std::vector<std::pair<double, bool>> generateLinearTicks(double tickStart, double tickDelta) const;
     // Generate logarithmic ticks
     std::vector<std::pair<double, bool>> generateLogarithmicTicks() const;
+    // Generate time ticks on calendar boundaries
+    std::vector<std::pair<double, bool>> generateTimeTicks() const;
+    // Return label for the specified absolute tick time
+    const QString &timeLabel(std::int64_t time) const;
 
     public:
+    // Return ticks for the current axis range, flagging those which are labelled
+    std::vector<std::pair<double, bool>> ticks() const;
     // Return the minimum display value of the axis
     double minimum() const;
     // Return the maximum display value of the axis
@@ -78,6 +100,14 @@ class AxisEntity : public Qt3DCore::QEntity
     void shiftLimitsByPixels(int pixelDelta);
     // Return whether the axis is logarithmic
     bool isLogarithmic() const;
+    // Return whether the axis represents time
+    bool isTimeAxis() const;
+    // Set time epoch (nanoseconds since the Unix epoch)
+    void setTimeEpoch(std::int64_t epoch);
+    // Return time epoch (nanoseconds since the Unix epoch)
+    std::int64_t timeEpoch() const;
+    // Return label text for the specified tick value
+    QString tickLabel(double value) const;
     // Set title text
     void setTitleText(const QString &text);
     // Return title text
@@ -90,9 +120,12 @@ class AxisEntity : public Qt3DCore::QEntity
     void setMaximum(double value);
     // Set whether the axis is logarithmic
     void setLogarithmic(bool b);
+    // Set whether the axis represents time
+    void setTimeAxis(bool b);
 
     signals:
     void rangeChanged();
+    void limitsChanged();
 
     /*
      * Layout
@@ -118,14 +151,22 @@ class AxisEntity : public Qt3DCore::QEntity
     void setDirection(QVector3D v);
     // Return explicit direction
     QVector3D direction() const;
+    // Return tick direction
+    QVector3D tickDirection() const;
+    // Return tick label anchor point
+    MildredMetrics::AnchorPoint labelAnchorPoint() const;
     // Get relevant scale from the supplied metrics
     double getAxisScale(const MildredMetrics &metrics) const;
     // Map axis value to scaled global position
     double toGlobal(double axisValue) const;
     // Map axis value to 3D point
     QVector3D to3D(double axisValue) const;
+    // Return scale factor between (transformed) axis values and scaled units
+    double scaleFactor() const;
     // Return scaled value point
     QVector3D toScaled(double axisValue) const;
+    // Return scaled value point relative to the specified origin
+    QVector3D toScaled(double axisValue, double origin) const;
     // Return axis value from scaled point
     double fromScaled(double scaledValue) const;
 
@@ -141,19 +182,30 @@ class AxisEntity : public Qt3DCore::QEntity
     std::vector<TextEntity *> tickLabelEntities_;
     // Axis title
     TextEntity *axisTitleEntity_{nullptr};
+    // Anchor position of axis title
+    QVector3D titleAnchorPosition_;
+    // Whether renderable geometry is created for the axis (otherwise only its layout is calculated)
+    bool geometryEnabled_{true};
 
     private:
     // Create / update ticks and labels at specified axis values, returning their bounding cuboid
     Cuboid createTickAndLabelEntities(const std::vector<std::pair<double, bool>> &ticks);
 
     public:
+    // Set whether renderable geometry is created for the axis
+    void setGeometryEnabled(bool enabled);
     // Return bounding cuboid for axis given its current settings and supplied metrics
     Cuboid boundingCuboid(const MildredMetrics &metrics) const;
+    // Return anchor position of axis title
+    QVector3D titleAnchorPosition() const;
 
     public slots:
     // Recreate axis entities from scratch using stored metrics
     void recreate();
 
+    signals:
+    void recreated();
+
     /*
      * Components
      */
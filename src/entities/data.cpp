@@ -49,14 +49,14 @@ const ColourDefinition &DataEntity::colour() const { return colour_; }
 void DataEntity::setColourOverride(const ColourDefinition &colour)
 {
     colourOverride_ = colour;
-    create();
+    updateRenderables();
 }
 
 // Remove colour definition override
 void DataEntity::removeColourOverride()
 {
     colourOverride_ = std::nullopt;
-    create();
+    updateRenderables();
 }
 
 // Set data entity material
@@ -133,5 +133,42 @@ Qt3DRender::QMaterial *DataEntity::symbolMaterial() { return symbolEntityMateria
  * Rendering
  */
 
-// Recreate renderables following metric / axis change
-void DataEntity::updateRenderables() { create(); }
+//! Set whether recreation of renderables is suspended
+/*!
+ * While suspended, requests to recreate renderables (e.g. following data or metric changes) are recorded but not acted upon.
+ * When resumed, any pending request is satisfied with a single recreation.
+ */
+void DataEntity::setRenderablesSuspended(bool suspended)
+{
+    renderablesSuspended_ = suspended;
+
+    if (!renderablesSuspended_ && renderablesPending_)
+        updateRenderables();
+}
+
+//! Return whether recreation of renderables is suspended
+bool DataEntity::renderablesSuspended() const { return renderablesSuspended_; }
+
+//! Recreate renderables following metric / axis change
+/*!
+ * Recreate all renderables for the entity from its current data and style. If recreation is currently suspended the request is
+ * deferred until it is resumed.
+ *
+ * Emits renderablesInvalidated(), and renderablesUpdated() once the renderables have been recreated.
+ */
+void DataEntity::updateRenderables()
+{
+    emit(renderablesInvalidated());
+
+    if (renderablesSuspended_)
+    {
+        renderablesPending_ = true;
+        return;
+    }
+
+    renderablesPending_ = false;
+
+    create();
+
+    emit(renderablesUpdated());
+}
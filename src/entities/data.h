@@ -60,9 +60,11 @@ class DataEntity : public Qt3DCore::QEntity
     /*
      * Components
      */
-    private:
+    protected:
     // Transform in 3D space, used internally for special positioning
     Qt3DCore::QTransform *positionalTransform_{nullptr};
+
+    private:
     // Material for data entity
     Qt3DRender::QMaterial *dataEntityMaterial_{nullptr};
     // Material for error entity
@@ -76,11 +78,9 @@ class DataEntity : public Qt3DCore::QEntity
     // Colour definition override
     std::optional<ColourDefinition> colourOverride_;
 
-    protected:
+    public:
     // Return colour definition to use
     ColourDefinition colourDefinition() const;
-
-    public:
     // Return local colour definition for entity
     ColourDefinition &colour();
     const ColourDefinition &colour() const;
@@ -104,12 +104,28 @@ class DataEntity : public Qt3DCore::QEntity
     /*
      * Rendering
      */
+    private:
+    // Whether recreation of renderables is suspended
+    bool renderablesSuspended_{false};
+    // Whether renderables need to be recreated once recreation is resumed
+    bool renderablesPending_{false};
+
     protected:
     // Create renderables from current data
     virtual void create() = 0;
 
+    public:
+    // Set whether recreation of renderables is suspended
+    void setRenderablesSuspended(bool suspended);
+    // Return whether recreation of renderables is suspended
+    bool renderablesSuspended() const;
+
     public slots:
     // Recreate renderables following metric / axis change
     void updateRenderables();
+
+    signals:
+    void renderablesInvalidated();
+    void renderablesUpdated();
 };
 } // namespace Mildred
\ No newline at end of file
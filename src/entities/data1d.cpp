@@ -1,5 +1,9 @@
 #include "entities/data1d.h"
 #include "renderers/1d/stylefactory.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 
 using namespace Mildred;
 
@@ -14,6 +18,7 @@ Data1DEntity::Data1DEntity(const AxisEntity *xAxis, const AxisEntity *valueAxis,
     dataRenderer_ = StyleFactory1D::createDataRenderer(style_, dataEntity_);
     errorRenderer_ = StyleFactory1D::createErrorRenderer(errorStyle_, errorEntity_);
     symbolRenderer_ = StyleFactory1D::createSymbolRenderer(symbolStyle_, symbolEntity_);
+    selectionEntity_ = new SubsetEntity(this);
 }
 
 /*
@@ -23,22 +28,64 @@ Data1DEntity::Data1DEntity(const AxisEntity *xAxis, const AxisEntity *valueAxis,
 //! Clear all data vectors
 void Data1DEntity::clearData()
 {
-    x_.clear();
-    values_.clear();
-    errors_.clear();
+    x_ = DataColumn();
+    values_ = DataColumn();
+    errors_ = DataColumn();
+    xAppendStorage_.reset();
+    valuesAppendStorage_.reset();
+    errorsAppendStorage_.reset();
+    cache_.reset();
+    xAscending_ = false;
+    spatialIndex_.reset();
+    selection_.clear();
+    selectionEntity_->clear();
     extrema_.reset();
     logarithmicExtrema_.reset();
 }
 
+//! Set storage precision for data supplied as vectors
+/*!
+ * Set the precision in which data subsequently supplied as std::vector<double> is stored. Single precision (Float32) halves
+ * the memory required, at the cost of resolution - all extrema and tick calculations are still performed in double precision.
+ * Data supplied as @class DataColumn objects is always stored as given.
+ */
+void Data1DEntity::setStoragePrecision(DataColumn::ElementType precision) { storagePrecision_ = precision; }
+
+//! Return storage precision for data supplied as vectors
+DataColumn::ElementType Data1DEntity::storagePrecision() const { return storagePrecision_; }
+
 //! Set display data (1D)
 /*!
- * Set the supplied one-dimensional data (axis points @param x and @param values at those points). The data are copied to local
- * arrays and entities representing the data in the current style are immediately created.
+ * Set the supplied one-dimensional data (axis points @param x and @param values at those points). The vectors are taken over by
+ * the entity (so are copied only if the caller passes lvalues) and entities representing the data in the current style are
+ * immediately created. Uniformly-spaced axis points are detected and stored as just a start value and step, and all other data
+ * are stored in the current storage precision.
  */
 void Data1DEntity::setData(std::vector<double> x, std::vector<double> values, std::optional<std::vector<double>> errors)
+{
+    std::optional<DataColumn> errorColumn;
+    if (errors)
+        errorColumn = DataColumn(std::move(*errors)).converted(storagePrecision_);
+
+    auto uniformX = DataColumn::detectUniform(x);
+    setData(uniformX ? *uniformX : DataColumn(std::move(x)).converted(storagePrecision_),
+            DataColumn(std::move(values)).converted(storagePrecision_), std::move(errorColumn));
+}
+
+//! Set display data from shared columns (1D)
+/*!
+ * Set the supplied one-dimensional data (axis points @param x and @param values at those points, with optional @param errors).
+ * Only references to the column storage are kept, so the same columns may be shared between many entities without copying.
+ * If the x axis represents time, 64-bit integer x values are taken to be nanoseconds since the Unix epoch, and are read
+ * relative to the axis time epoch without conversion.
+ */
+void Data1DEntity::setData(DataColumn x, DataColumn values, std::optional<DataColumn> errors)
 {
     clearData();
 
+    if (x.elementType() == DataColumn::ElementType::Int64 && xAxis_->isTimeAxis())
+        x = x.rebased(xAxis_->timeEpoch());
+
     // Check vector sizes
     if (x.size() != values.size())
         printf("Irregular vector sizes provided (%zu vs %zu) so data will be ignored.\n", x.size(), values.size());
@@ -53,10 +100,16 @@ void Data1DEntity::setData(std::vector<double> x, std::vector<double> values, st
             errors_ = std::move(*errors);
     }
 
-    // Determine data extrema
+    // Determine data extrema, and whether axis values are ascending, in a single pass through the data
+    xAscending_ = true;
+    auto lastX = -std::numeric_limits<double>::infinity();
     auto xit = x_.cbegin(), vit = values_.cbegin(), eit = errors_.cbegin();
     while (xit != x_.end())
     {
+        if (!(*xit >= lastX))
+            xAscending_ = false;
+        lastX = *xit;
+
         if (errors_.empty())
             updateExtrema(*xit, *vit, std::nullopt);
         else
@@ -70,22 +123,280 @@ void Data1DEntity::setData(std::vector<double> x, std::vector<double> values, st
         ++vit;
     }
 
-    create();
+    updateRenderables();
+}
+
+//! Set display data from cache (1D)
+/*!
+ * Set data from the supplied @param cache, referencing its full-resolution columns. Extrema are taken from the cache rather
+ * than calculated, and decimated data are drawn from its levels of detail, so no data are read other than those displayed. As
+ * for other data, Int64 axis values are displayed relative to the time epoch if the x axis is a time axis.
+ */
+void Data1DEntity::setData(std::shared_ptr<const ColumnCache> cache)
+{
+    clearData();
+
+    if (!cache)
+    {
+        updateRenderables();
+        return;
+    }
+
+    auto &full = cache->level(0);
+    x_ = full.x;
+    if (x_.elementType() == DataColumn::ElementType::Int64 && xAxis_->isTimeAxis())
+        x_ = x_.rebased(xAxis_->timeEpoch());
+    values_ = full.values;
+    errors_ = full.errors;
+    xAscending_ = cache->isAscending();
+    if (cache->nPoints() > 0)
+    {
+        // Extrema of Int64 axis values are stored relative to the base of the cached column, so shift them to our own
+        auto xShift = double(full.x.base() - x_.base());
+        auto &extrema = cache->extrema();
+        updateExtrema(extrema.xMinimum + xShift, extrema.valueMinimum, std::nullopt);
+        updateExtrema(extrema.xMaximum + xShift, extrema.valueMaximum, std::nullopt);
+
+        // Positive minima are only required for logarithmic extrema, and always lie within the linear extrema
+        auto [xPositive, valuePositive] = cache->positiveMinima();
+        updateExtrema(xPositive > 0.0 && xShift == 0.0 ? xPositive : extrema.xMinimum + xShift,
+                      valuePositive > 0.0 ? valuePositive : extrema.valueMinimum, std::nullopt);
+    }
+    cache_ = std::move(cache);
+
+    updateRenderables();
+}
+
+//! Append display data from columns (1D)
+/*!
+ * Append the supplied one-dimensional data (axis points @param x and @param values at those points, with optional @param
+ * errors) to the current data, for example as successive parts of a file are loaded. Appended data are copied into growable
+ * storage owned by the entity, so the cost of appending is proportional to the size of the new data, and only the extrema of
+ * the new data need be determined.
+ */
+void Data1DEntity::appendData(DataColumn x, DataColumn values, std::optional<DataColumn> errors)
+{
+    if (x_.empty())
+    {
+        setData(std::move(x), std::move(values), std::move(errors));
+        return;
+    }
+
+    if (x.elementType() == DataColumn::ElementType::Int64 && xAxis_->isTimeAxis())
+        x = x.rebased(xAxis_->timeEpoch());
+
+    // Check vector sizes
+    if (x.size() != values.size() || (errors && x.size() != errors->size()))
+    {
+        printf("Irregular vector sizes provided (%zu (x) vs %zu (y) vs %zu (errors)) so data will not be appended.\n", x.size(),
+               values.size(), errors ? errors->size() : 0);
+        return;
+    }
+    if (errors_.empty() == bool(errors))
+    {
+        printf("Errors %s for appended data but %s for existing data, so data will not be appended.\n",
+               errors ? "provided" : "not provided", errors_.empty() ? "absent" : "present");
+        return;
+    }
+
+    // Append to existing storage if it has capacity, otherwise copy into new storage with room to grow - existing columns
+    // (including any held elsewhere) only ever reference the unchanged start of the storage
+    auto append = [](std::shared_ptr<std::vector<double>> &storage, const DataColumn &current, const DataColumn &extra) {
+        if (!storage || storage->capacity() < current.size() + extra.size())
+        {
+            auto grown = std::make_shared<std::vector<double>>();
+            grown->reserve(2 * (current.size() + extra.size()));
+            grown->insert(grown->end(), current.begin(), current.end());
+            storage = grown;
+        }
+        storage->insert(storage->end(), extra.begin(), extra.end());
+        return DataColumn(storage->data(), storage->size(), storage);
+    };
+
+    // Update extrema, and whether axis values are ascending, for the new data
+    auto lastX = x_[x_.size() - 1];
+    for (std::size_t n = 0; n < x.size(); ++n)
+    {
+        if (!(x[n] >= lastX))
+            xAscending_ = false;
+        lastX = x[n];
+
+        if (errors_.empty())
+            updateExtrema(x[n], values[n], std::nullopt);
+        else
+        {
+            updateExtrema(x[n], values[n] + (*errors)[n], std::nullopt);
+            updateExtrema(x[n], values[n] - (*errors)[n], std::nullopt);
+        }
+    }
+
+    cache_.reset();
+    x_ = append(xAppendStorage_, x_, x);
+    values_ = append(valuesAppendStorage_, values_, values);
+    if (errors)
+        errors_ = append(errorsAppendStorage_, errors_, *errors);
+    spatialIndex_.reset();
+
+    updateRenderables();
+}
+
+//! Set display data with uniformly-spaced axis values (1D)
+/*!
+ * Set the supplied one-dimensional @param values (with optional @param errors), the first located at @param xStart along the
+ * x axis and each subsequent value @param xStep further along. No storage is required for the axis values.
+ */
+void Data1DEntity::setUniformData(double xStart, double xStep, DataColumn values, std::optional<DataColumn> errors)
+{
+    auto x = DataColumn::uniform(xStart, xStep, values.size());
+    setData(std::move(x), std::move(values), std::move(errors));
+}
+
+//! Return axis values
+const DataColumn &Data1DEntity::x() const { return x_; }
+
+//! Return data values
+const DataColumn &Data1DEntity::values() const { return values_; }
+
+//! Return error values
+const DataColumn &Data1DEntity::errors() const { return errors_; }
+
+//! Return range of indices of data points which may lie within the specified axis limits
+/*!
+ * Return the half-open range of indices of data points whose axis values may lie within [@param xMin, @param xMax], extended by
+ * one point either side so that lines crossing the limits are complete. The range is found directly for uniform axis values and
+ * by binary search for other ascending values, and otherwise covers all points.
+ */
+std::pair<int, int> Data1DEntity::indexRange(double xMin, double xMax) const
+{
+    if (!xAscending_)
+        return {0, int(x_.size())};
+
+    auto [first, last] = x_.indexRange(xMin, xMax);
+    return {std::max(int(first) - 1, 0), std::min(int(last) + 1, int(x_.size()))};
 }
 
 /*
  * Rendering
  */
 
+//! Return data to display for the current axis limits
+/*!
+ * Small datasets are displayed in full. For datasets with ascending x values and many more points than there are pixels along
+ * the x axis, only points within the current x axis limits are displayed and, if there are still too many, these are
+ * decimated by retaining only the first, last, minimum, and maximum points within each pixel column (M4 decimation). The
+ * resulting line is indistinguishable from that of the full data, but the number of vertices is bounded by the width of the
+ * axis, and only the visible part of the data is ever read. Such windowed data must be recreated whenever the x axis limits
+ * change (see isWindowed()).
+ * Data opened from a @class ColumnCache are decimated from its precomputed levels of detail, so that the number of points read
+ * is bounded by the width of the axis regardless of how much of the data is visible.
+ */
+std::tuple<DataColumn, DataColumn, DataColumn> Data1DEntity::displayData()
+{
+    const auto pointsPerPixel = 4;
+    auto nPixels = std::max(1, int(std::ceil(xAxis_->toScaled(xAxis_->maximum(), xAxis_->minimum()).length())));
+
+    windowed_ = xAscending_ && x_.size() > std::size_t(2 * pointsPerPixel * nPixels);
+    if (!windowed_)
+        return {x_, values_, errors_};
+
+    // Restrict to visible points
+    auto [first, last] = indexRange(xAxis_->minimum(), xAxis_->maximum());
+    auto nPoints = std::size_t(last - first);
+    if (nPoints <= std::size_t(pointsPerPixel * nPixels))
+        return {x_.slice(first, nPoints), values_.slice(first, nPoints), errors_.slice(first, nPoints)};
+
+    // Decimate from the coarsest level of detail in the cache (if any) whose buckets span no more than one pixel column
+    // -- Int64 axis values of the levels are relative to the base of the cached column, so must be rebased to match our own
+    DataColumn levelX;
+    const DataColumn *xSource = &x_, *valueSource = &values_, *errorSource = &errors_;
+    for (auto n = cache_ ? cache_->nLevels() - 1 : 0; n > 0; --n)
+    {
+        auto &level = cache_->level(n);
+        if (level.bucketSize > nPoints / nPixels)
+            continue;
+
+        levelX = level.x.rebased(x_.base());
+        auto [levelFirst, levelLast] = levelX.indexRange(xAxis_->minimum(), xAxis_->maximum());
+        first = std::max(int(levelFirst) - 1, 0);
+        last = std::min(int(levelLast) + 1, int(levelX.size()));
+        xSource = &levelX;
+        valueSource = &level.values;
+        errorSource = &level.errors;
+        break;
+    }
+
+    // Determine indices of the points to retain in each pixel column
+    auto transform = [logarithmic = xAxis_->isLogarithmic()](double v) { return logarithmic ? log10(v) : v; };
+    auto xMin = transform(xAxis_->minimum());
+    auto pixelsPerUnit = nPixels / (transform(xAxis_->maximum()) - xMin);
+    std::vector<int> indices;
+    indices.reserve(pointsPerPixel * (nPixels + 2));
+    auto column = -1, columnFirst = 0, columnMin = 0, columnMax = 0, columnLast = 0;
+    auto flush = [&]() {
+        if (column == -1)
+            return;
+        std::array<int, 4> candidates{columnFirst, columnMin, columnMax, columnLast};
+        std::sort(candidates.begin(), candidates.end());
+        for (auto n = 0; n < 4; ++n)
+            if (n == 0 || candidates[n] != candidates[n - 1])
+                indices.push_back(candidates[n]);
+    };
+    for (auto n = first; n < last; ++n)
+    {
+        auto pixel = std::clamp(int(floor((transform((*xSource)[n]) - xMin) * pixelsPerUnit)), 0, nPixels - 1);
+        if (pixel != column)
+        {
+            flush();
+            column = pixel;
+            columnFirst = columnMin = columnMax = n;
+        }
+        else
+        {
+            auto value = (*valueSource)[n];
+            if (value < (*valueSource)[columnMin] || std::isnan((*valueSource)[columnMin]))
+                columnMin = n;
+            if (value > (*valueSource)[columnMax] || std::isnan((*valueSource)[columnMax]))
+                columnMax = n;
+        }
+        columnLast = n;
+    }
+    flush();
+
+    // Gather the retained points
+    std::vector<double> x(indices.size()), values(indices.size()), errors(errorSource->empty() ? 0 : indices.size());
+    for (auto n = 0; n < int(indices.size()); ++n)
+    {
+        x[n] = (*xSource)[indices[n]];
+        values[n] = (*valueSource)[indices[n]];
+        if (!errorSource->empty())
+            errors[n] = (*errorSource)[indices[n]];
+    }
+
+    return {DataColumn(std::move(x)), DataColumn(std::move(values)), DataColumn(std::move(errors))};
+}
+
+//! Return whether displayed data are restricted to the visible x range, and so must be recreated when the x axis limits change
+bool Data1DEntity::isWindowed() const { return windowed_; }
+
 //! Create renderables in the current style
 void Data1DEntity::create()
 {
+    updateOrigin();
+    updateOriginTransform();
+
+    auto [x, values, errors] = displayData();
+
     assert(dataRenderer_);
-    dataRenderer_->create(colourDefinition(), x_, xAxis_, values_, valueAxis_);
+    dataRenderer_->setOrigin(xOrigin_, valueOrigin_);
+    dataRenderer_->create(colourDefinition(), x, xAxis_, values, valueAxis_);
     assert(errorRenderer_);
-    errorRenderer_->create(colourDefinition(), x_, xAxis_, values_, errors_, valueAxis_);
+    errorRenderer_->setOrigin(xOrigin_, valueOrigin_);
+    errorRenderer_->create(colourDefinition(), x, xAxis_, values, errors, valueAxis_);
     assert(symbolRenderer_);
-    symbolRenderer_->create(colourDefinition(), x_, xAxis_, values_, valueAxis_);
+    symbolRenderer_->setOrigin(xOrigin_, valueOrigin_);
+    symbolRenderer_->create(colourDefinition(), x, xAxis_, values, valueAxis_);
+
+    updateSelectionEntity();
 }
 
 //! Set the line style
@@ -95,9 +406,12 @@ void Data1DEntity::setLineStyle(StyleFactory1D::Style style)
     dataRenderer_ = StyleFactory1D::createDataRenderer(style_, dataEntity_);
     if (dataMaterial())
         setDataMaterial(dataMaterial());
-    create();
+    updateRenderables();
 }
 
+//! Return line style
+StyleFactory1D::Style Data1DEntity::lineStyle() const { return style_; }
+
 //! Set the error style
 void Data1DEntity::setErrorStyle(StyleFactory1D::ErrorBarStyle style)
 {
@@ -105,14 +419,17 @@ void Data1DEntity::setErrorStyle(StyleFactory1D::ErrorBarStyle style)
     errorRenderer_ = StyleFactory1D::createErrorRenderer(errorStyle_, errorEntity_);
     if (errorMaterial())
         setErrorMaterial(errorMaterial());
-    create();
+    updateRenderables();
 }
 
+//! Return error style
+StyleFactory1D::ErrorBarStyle Data1DEntity::errorStyle() const { return errorStyle_; }
+
 //! Set error size
 void Data1DEntity::setErrorBarMetric(double metric)
 {
     errorRenderer_->setErrorBarMetric(metric);
-    create();
+    updateRenderables();
 }
 
 //! Get error size
@@ -125,15 +442,172 @@ void Data1DEntity::setSymbolStyle(StyleFactory1D::SymbolStyle style)
     symbolRenderer_ = StyleFactory1D::createSymbolRenderer(symbolStyle_, symbolEntity_);
     if (symbolMaterial())
         setSymbolMaterial(symbolMaterial());
-    create();
+    updateRenderables();
 }
 
+//! Return symbol style
+StyleFactory1D::SymbolStyle Data1DEntity::symbolStyle() const { return symbolStyle_; }
+
 //! Set symbol size
 void Data1DEntity::setSymbolMetric(double metric)
 {
     symbolRenderer_->setSymbolMetric(metric);
-    create();
+    updateRenderables();
 }
 
 //! Get symbol size
 double Data1DEntity::symbolMetric() const { return symbolRenderer_->symbolMetric(); }
+
+/*
+ * Origin
+ */
+
+//! Choose origin for current axis limits and types
+/*!
+ * The origin is taken to be the centre of the current axis limits (rather than a point of the data), so that the positions of
+ * visible data relative to it are small however far the view is zoomed in. Since renderables are recreated whenever the axis
+ * scale changes, the origin follows the view when zooming.
+ */
+void Data1DEntity::updateOrigin()
+{
+    auto centre = [](const AxisEntity *axis) {
+        return axis->isLogarithmic() ? sqrt(axis->minimum() * axis->maximum()) : 0.5 * (axis->minimum() + axis->maximum());
+    };
+
+    xOrigin_ = centre(xAxis_);
+    valueOrigin_ = centre(valueAxis_);
+}
+
+//! Return origin of data
+QPointF Data1DEntity::origin() const { return {xOrigin_, valueOrigin_}; }
+
+//! Update transform placing the data origin relative to the axes origin
+/*!
+ * Translate the entity by the scaled offset of the data origin from the minima of its axes, calculated in double precision.
+ * This must be called whenever the axis limits change, but the renderables themselves need only be recreated if the axis
+ * scale or type has changed.
+ */
+void Data1DEntity::updateOriginTransform()
+{
+    positionalTransform_->setTranslation(xAxis_->toScaled(xOrigin_, xAxis_->minimum()) +
+                                         valueAxis_->toScaled(valueOrigin_, valueAxis_->minimum()));
+}
+
+/*
+ * Queries
+ */
+
+//! Return spatial index, building it if necessary
+/*!
+ * The index is built on first use following a change in data or axis type.
+ */
+const SpatialIndex &Data1DEntity::spatialIndex() const
+{
+    if (!spatialIndex_.isValid(xAxis_->isLogarithmic(), valueAxis_->isLogarithmic()))
+        spatialIndex_.build(x_, values_, xAxis_->isLogarithmic(), valueAxis_->isLogarithmic());
+
+    return spatialIndex_;
+}
+
+//! Return index of, and scaled distance to, the data point nearest to the specified axis coordinates
+/*!
+ * Find the data point nearest to @param value (given in axis coordinates), measuring distances in scaled (pixel) units along
+ * the current axes. Only points within @param maximumDistance are considered. The spatial index used to accelerate the search
+ * is built on first use following a change in data or axis type, so repeated queries (e.g. when hovering) are inexpensive.
+ */
+std::optional<std::pair<int, double>> Data1DEntity::nearestPoint(QPointF value, double maximumDistance) const
+{
+    if (!xAxis_ || !valueAxis_ || x_.empty())
+        return std::nullopt;
+
+    return spatialIndex().nearest(value.x(), value.y(), xAxis_->scaleFactor(), valueAxis_->scaleFactor(), maximumDistance);
+}
+
+//! Return indices of data points within the specified rectangle in axis coordinates
+std::vector<int> Data1DEntity::pointsInRectangle(const QRectF &rect) const
+{
+    if (!xAxis_ || !valueAxis_ || x_.empty())
+        return {};
+
+    auto r = rect.normalized();
+    return spatialIndex().withinRectangle(r.left(), r.top(), r.right(), r.bottom());
+}
+
+//! Return indices of data points within the specified polygon in axis coordinates
+/*!
+ * Return the indices of all data points within the closed @param polygon. Polygon edges are straight in display space, so
+ * follow the current axis types.
+ */
+std::vector<int> Data1DEntity::pointsInPolygon(const QPolygonF &polygon) const
+{
+    if (!xAxis_ || !valueAxis_ || x_.empty())
+        return {};
+
+    std::vector<std::pair<double, double>> vertices;
+    vertices.reserve(polygon.size());
+    for (auto &p : polygon)
+        vertices.emplace_back(p.x(), p.y());
+    return spatialIndex().withinPolygon(vertices);
+}
+
+/*
+ * Selection
+ */
+
+//! Update selection entity to reflect the current selection
+/*!
+ * Selected points are drawn by indexing into the vertex buffer of the line renderer, which contains one vertex per data point,
+ * so only the selected indices need be uploaded. If the current line style provides no such buffer, the positions of the
+ * selected points are supplied directly.
+ */
+void Data1DEntity::updateSelectionEntity()
+{
+    if (selection_.empty())
+    {
+        selectionEntity_->clear();
+        return;
+    }
+
+    auto *source = dataRenderer_ ? dataRenderer_->pointVertices() : nullptr;
+    if (source && source->vertexCount() == int(x_.size()))
+        selectionEntity_->set(source, selection_);
+    else
+    {
+        std::vector<QVector3D> vertices;
+        vertices.reserve(selection_.size());
+        for (auto i : selection_)
+            vertices.push_back(xAxis_->toScaled(x_[i], xOrigin_) + valueAxis_->toScaled(values_[i], valueOrigin_));
+        selectionEntity_->set(vertices);
+    }
+}
+
+//! Set indices of selected data points
+/*!
+ * Set the selected data points to those given by @param indices, which must be valid for the current data.
+ */
+void Data1DEntity::setSelection(std::vector<int> indices)
+{
+    selection_ = std::move(indices);
+
+    updateSelectionEntity();
+}
+
+//! Clear selection
+void Data1DEntity::clearSelection() { setSelection({}); }
+
+//! Return indices of selected data points
+const std::vector<int> &Data1DEntity::selection() const { return selection_; }
+
+//! Set selection entity material
+void Data1DEntity::setSelectionMaterial(Qt3DRender::QMaterial *material)
+{
+    if (selectionEntityMaterial_)
+        selectionEntity_->removeComponent(selectionEntityMaterial_);
+
+    selectionEntityMaterial_ = material;
+    if (selectionEntityMaterial_)
+        selectionEntity_->addComponent(selectionEntityMaterial_);
+}
+
+//! Set whether the selection is displayed
+void Data1DEntity::setSelectionVisible(bool visible) { selectionEntity_->setEnabled(visible); }
@@ -1,7 +1,13 @@
 #pragma once
 
+#include "classes/datacolumn.h"
+#include "classes/spatialindex.h"
 #include "entities/data.h"
+#include "entities/subset.h"
+#include "io/columncache.h"
 #include "renderers/1d/stylefactory.h"
+#include <QPolygonF>
+#include <tuple>
 
 namespace Mildred
 {
@@ -13,7 +19,17 @@ class AxisEntity;
  * Data1DEntity provides a general class to contain and display a single one-dimensional dataset.
  *
  * Data passed to the class in the form of two std::vector<double> containing x axis points and y axis values. The sizes of the
- * two arrays must match.
+ * two arrays must match. Alternatively, data may be supplied as shared @class DataColumn objects, allowing many entities to
+ * reference the same storage (e.g. a common x axis) without copying it. Uniformly-spaced x values are stored as just a start
+ * value and step, and data may be stored in single precision (see setStoragePrecision()) to halve memory use. Timestamps may
+ * be supplied directly as 64-bit integer nanoseconds for display against a time axis. Very large datasets may be opened from a
+ * @class ColumnCache, from which only the data (and levels of detail) required for display are read.
+ *
+ * Vertex positions are generated relative to a double-precision origin at the centre of the axis limits in effect when the
+ * renderables were created, and the entity is then translated from the axes origin to the data origin. Since both the relative
+ * positions and the translation are calculated in double precision before conversion to floats, and the origin is re-centred
+ * whenever zooming recreates the renderables, large-magnitude data (e.g. timestamps) may be zoomed into without loss of
+ * precision. Panning requires only the translation to be updated.
  */
 class Data1DEntity : public DataEntity
 {
@@ -28,17 +44,49 @@ class Data1DEntity : public DataEntity
      */
     protected:
     // Axis values
-    std::vector<double> x_;
+    DataColumn x_;
     // Data values
-    std::vector<double> values_;
+    DataColumn values_;
     // Error values
-    std::vector<double> errors_;
+    DataColumn errors_;
+    // Whether axis values are in ascending order
+    bool xAscending_{false};
+    // Whether displayed data are restricted to the visible x range (and decimated), and so must follow x axis limit changes
+    bool windowed_{false};
+    // Growable storage for appended data, referenced by the current columns
+    std::shared_ptr<std::vector<double>> xAppendStorage_, valuesAppendStorage_, errorsAppendStorage_;
+    // Cache providing the current data, if any
+    std::shared_ptr<const ColumnCache> cache_;
+    // Storage precision for data supplied as vectors
+    DataColumn::ElementType storagePrecision_{DataColumn::ElementType::Float64};
 
     public:
+    // Set storage precision for data supplied as vectors
+    void setStoragePrecision(DataColumn::ElementType precision);
+    // Return storage precision for data supplied as vectors
+    DataColumn::ElementType storagePrecision() const;
     // Clear all data
     void clearData();
     // Set display data
     void setData(std::vector<double> x, std::vector<double> values, std::optional<std::vector<double>> errors = std::nullopt);
+    // Set display data from shared columns
+    void setData(DataColumn x, DataColumn values, std::optional<DataColumn> errors = std::nullopt);
+    // Set display data from cache
+    void setData(std::shared_ptr<const ColumnCache> cache);
+    // Append display data from columns
+    void appendData(DataColumn x, DataColumn values, std::optional<DataColumn> errors = std::nullopt);
+    // Set display data with uniformly-spaced axis values
+    void setUniformData(double xStart, double xStep, DataColumn values, std::optional<DataColumn> errors = std::nullopt);
+    // Return axis values
+    const DataColumn &x() const;
+    // Return data values
+    const DataColumn &values() const;
+    // Return error values
+    const DataColumn &errors() const;
+    // Return range of indices of data points which may lie within the specified axis limits
+    std::pair<int, int> indexRange(double xMin, double xMax) const;
+    // Return whether displayed data are restricted to the visible x range
+    bool isWindowed() const;
 
     /*
      * Rendering
@@ -64,21 +112,94 @@ class Data1DEntity : public DataEntity
     public:
     // Set line style
     void setLineStyle(StyleFactory1D::Style style);
+    // Return line style
+    StyleFactory1D::Style lineStyle() const;
     // Set error style
     void setErrorStyle(StyleFactory1D::ErrorBarStyle style);
+    // Return error style
+    StyleFactory1D::ErrorBarStyle errorStyle() const;
     // Set error size
     void setErrorBarMetric(double metric);
     // Get error size
     double errorBarMetric() const;
     // Set symbol style
     void setSymbolStyle(StyleFactory1D::SymbolStyle style);
+    // Return symbol style
+    StyleFactory1D::SymbolStyle symbolStyle() const;
     // Set symbol size
     void setSymbolMetric(double metric);
     // Get symbol size
     double symbolMetric() const;
 
+    private:
+    // Return data to display for the current axis limits
+    std::tuple<DataColumn, DataColumn, DataColumn> displayData();
+
     protected:
     // Create renderables from current data
     void create() override;
+
+    /*
+     * Origin
+     */
+    private:
+    // Origin of data, relative to which vertex positions are generated
+    double xOrigin_{0.0}, valueOrigin_{0.0};
+
+    private:
+    // Choose origin for current axis limits and types
+    void updateOrigin();
+
+    public:
+    // Return origin of data
+    QPointF origin() const;
+    // Update transform placing the data origin relative to the axes origin
+    void updateOriginTransform();
+
+    /*
+     * Queries
+     */
+    private:
+    // Spatial index over the current data, built on demand
+    mutable SpatialIndex spatialIndex_;
+
+    private:
+    // Return spatial index, building it if necessary
+    const SpatialIndex &spatialIndex() const;
+
+    public:
+    // Return index of, and scaled distance to, the data point nearest to the specified axis coordinates
+    std::optional<std::pair<int, double>> nearestPoint(QPointF value, double maximumDistance) const;
+    // Return indices of data points within the specified rectangle in axis coordinates
+    std::vector<int> pointsInRectangle(const QRectF &rect) const;
+    // Return indices of data points within the specified polygon in axis coordinates
+    std::vector<int> pointsInPolygon(const QPolygonF &polygon) const;
+
+    /*
+     * Selection
+     */
+    private:
+    // Indices of selected data points
+    std::vector<int> selection_;
+    // Entity highlighting selected data points
+    SubsetEntity *selectionEntity_{nullptr};
+    // Material for selection entity
+    Qt3DRender::QMaterial *selectionEntityMaterial_{nullptr};
+
+    private:
+    // Update selection entity to reflect the current selection
+    void updateSelectionEntity();
+
+    public:
+    // Set indices of selected data points
+    void setSelection(std::vector<int> indices);
+    // Clear selection
+    void clearSelection();
+    // Return indices of selected data points
+    const std::vector<int> &selection() const;
+    // Set selection entity material
+    void setSelectionMaterial(Qt3DRender::QMaterial *material);
+    // Set whether the selection is displayed
+    void setSelectionVisible(bool visible);
 };
 } // namespace Mildred
\ No newline at end of file
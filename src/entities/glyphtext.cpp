@@ -0,0 +1,148 @@
+#include "entities/glyphtext.h"
+#include <QFontMetricsF>
+#include <cmath>
+
+using namespace Mildred;
+
+//! Construct a new GlyphTextEntity
+/*!
+ * Creates an empty GlyphTextEntity drawing text in the specified fixed-width @param font. Each of the characters in @param
+ * glyphs is painted once into the atlas, at @param atlasScale times its displayed size so that it remains sharp on high
+ * resolution targets.
+ */
+GlyphTextEntity::GlyphTextEntity(Qt3DCore::QNode *parent, const QFont &font, const QString &glyphs, double atlasScale)
+    : Qt3DCore::QEntity(parent), geometry_(this), geometryRenderer_(this), vertexBuffer_(&geometry_),
+      vertexAttribute_(&geometry_), texCoordAttribute_(&geometry_), glyphs_(glyphs)
+{
+    QFontMetricsF metrics(font);
+    cellSize_ = QSizeF(metrics.horizontalAdvance(QLatin1Char('0')), metrics.height());
+
+    // Set up interleaved position and texture coordinate attributes
+    vertexAttribute_.setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+    vertexAttribute_.setVertexBaseType(Qt3DCore::QAttribute::Float);
+    vertexAttribute_.setVertexSize(3);
+    vertexAttribute_.setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    vertexAttribute_.setBuffer(&vertexBuffer_);
+    vertexAttribute_.setByteStride(5 * sizeof(float));
+    vertexAttribute_.setCount(0);
+    texCoordAttribute_.setName(Qt3DCore::QAttribute::defaultTextureCoordinateAttributeName());
+    texCoordAttribute_.setVertexBaseType(Qt3DCore::QAttribute::Float);
+    texCoordAttribute_.setVertexSize(2);
+    texCoordAttribute_.setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    texCoordAttribute_.setBuffer(&vertexBuffer_);
+    texCoordAttribute_.setByteOffset(3 * sizeof(float));
+    texCoordAttribute_.setByteStride(5 * sizeof(float));
+    texCoordAttribute_.setCount(0);
+    geometry_.addAttribute(&vertexAttribute_);
+    geometry_.addAttribute(&texCoordAttribute_);
+
+    geometryRenderer_.setGeometry(&geometry_);
+    geometryRenderer_.setPrimitiveType(Qt3DRender::QGeometryRenderer::Triangles);
+    addComponent(&geometryRenderer_);
+
+    transform_ = new Qt3DCore::QTransform(this);
+    addComponent(transform_);
+
+    // Create the atlas - a single row of character cells, painted once
+    QSize atlasSize(int(ceil(cellSize_.width() * atlasScale)) * glyphs_.size(), int(ceil(cellSize_.height() * atlasScale)));
+    texture_ = new Qt3DRender::QTexture2D(this);
+    texture_->setFormat(Qt3DRender::QAbstractTexture::RGBA8_UNorm);
+    texture_->setGenerateMipMaps(false);
+    texture_->setMinificationFilter(Qt3DRender::QAbstractTexture::Linear);
+    texture_->setMagnificationFilter(Qt3DRender::QAbstractTexture::Linear);
+    texture_->setSize(atlasSize.width(), atlasSize.height());
+    image_ = new LayerCacheImage(texture_);
+    image_->setPaintFunction([font, glyphs, atlasSize, atlasScale, cellSize = cellSize_](QPainter &painter) {
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(QRect(QPoint(0, 0), atlasSize), Qt::transparent);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter.setPen(Qt::black);
+        painter.setFont(font);
+        auto cellWidth = double(atlasSize.width()) / glyphs.size();
+        painter.scale(atlasScale, atlasScale);
+        for (auto n = 0; n < glyphs.size(); ++n)
+            painter.drawText(QRectF(n * cellWidth / atlasScale, 0.0, cellSize.width(), cellSize.height()), Qt::AlignCenter,
+                             glyphs.mid(n, 1));
+    });
+    image_->setSize(atlasSize);
+    texture_->addTextureImage(image_);
+}
+
+//! Return texture containing the glyph atlas
+Qt3DRender::QAbstractTexture *GlyphTextEntity::texture() const { return texture_; }
+
+/*
+ * Definition
+ */
+
+//! Update translation
+void GlyphTextEntity::updateTranslation()
+{
+    auto location = MildredMetrics::anchorLocation(anchorPoint_);
+    transform_->setTranslation(anchorPosition_ - QVector3D(location.x() * cellSize_.width() * text_.size(),
+                                                           location.y() * cellSize_.height(), 0.0));
+}
+
+//! Set text
+/*!
+ * Set the displayed @param text, rewriting the vertex buffer with one quad (two triangles) per character.
+ */
+void GlyphTextEntity::setText(const QString &text)
+{
+    if (text == text_)
+        return;
+
+    auto widthChanged = text.size() != text_.size();
+    text_ = text;
+
+    QByteArray vertexBytes;
+    vertexBytes.resize(text_.size() * 6 * 5 * sizeof(float));
+    auto *data = reinterpret_cast<float *>(vertexBytes.data());
+    auto glyphWidth = 1.0 / glyphs_.size();
+    auto addVertex = [&](double x, double y, double u, double v) {
+        *data++ = x;
+        *data++ = y;
+        *data++ = 0.0f;
+        *data++ = u;
+        *data++ = v;
+    };
+    for (auto n = 0; n < text_.size(); ++n)
+    {
+        auto glyph = std::max(0, int(glyphs_.indexOf(text_[n])));
+        auto x0 = n * cellSize_.width(), x1 = x0 + cellSize_.width(), y1 = cellSize_.height();
+        auto u0 = glyph * glyphWidth, u1 = u0 + glyphWidth;
+
+        // Texture coordinates are flipped vertically since painted images are stored top row first
+        addVertex(x0, 0.0, u0, 1.0);
+        addVertex(x1, 0.0, u1, 1.0);
+        addVertex(x1, y1, u1, 0.0);
+        addVertex(x0, 0.0, u0, 1.0);
+        addVertex(x1, y1, u1, 0.0);
+        addVertex(x0, y1, u0, 0.0);
+    }
+    vertexBuffer_.setData(vertexBytes);
+    vertexAttribute_.setCount(text_.size() * 6);
+    texCoordAttribute_.setCount(text_.size() * 6);
+
+    if (widthChanged)
+        updateTranslation();
+}
+
+//! Return current text
+QString GlyphTextEntity::text() const { return text_; }
+
+//! Set anchor point
+void GlyphTextEntity::setAnchorPoint(MildredMetrics::AnchorPoint anchor)
+{
+    anchorPoint_ = anchor;
+
+    updateTranslation();
+}
+
+//! Set anchor position
+void GlyphTextEntity::setAnchorPosition(QVector3D p)
+{
+    anchorPosition_ = p;
+
+    updateTranslation();
+}
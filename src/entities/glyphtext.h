@@ -0,0 +1,75 @@
+#pragma once
+
+#include "classes/metrics.h"
+#include "entities/layercache.h"
+#include <QFont>
+#include <Qt3DCore/QTransform>
+
+namespace Mildred
+{
+//! GlyphTextEntity renders short, frequently-changing strings from a pre-rendered glyph atlas
+/*!
+ * GlyphTextEntity displays a single line of text in a fixed-width font as a set of textured quads, one per character, sampling
+ * a glyph atlas which is painted once on construction. Changing the text only rewrites a small vertex buffer, and changing its
+ * position only updates a transform, so the entity is suitable for text which changes every frame (e.g. the mouse coordinate
+ * readout). Characters not present in the atlas are drawn as spaces.
+ *
+ * The entity requires a material with the Glyph vertex and fragment shaders, to which the texture returned by texture() should
+ * be supplied as the "glyphTexture" parameter.
+ */
+class GlyphTextEntity : public Qt3DCore::QEntity
+{
+    public:
+    GlyphTextEntity(Qt3DCore::QNode *parent, const QFont &font,
+                    const QString &glyphs = QStringLiteral(" +-.0123456789aefinEINFA"), double atlasScale = 2.0);
+    ~GlyphTextEntity() = default;
+
+    private:
+    // Quad geometry
+    Qt3DCore::QGeometry geometry_;
+    // Renderer for quad geometry
+    Qt3DRender::QGeometryRenderer geometryRenderer_;
+    // Buffer and attributes
+    Qt3DCore::QBuffer vertexBuffer_;
+    Qt3DCore::QAttribute vertexAttribute_;
+    Qt3DCore::QAttribute texCoordAttribute_;
+    // Positional transform
+    Qt3DCore::QTransform *transform_{nullptr};
+    // Glyph atlas texture, and its image
+    Qt3DRender::QTexture2D *texture_{nullptr};
+    LayerCacheImage *image_{nullptr};
+    // Characters present in the atlas
+    QString glyphs_;
+    // Size of each character cell, in scene units
+    QSizeF cellSize_;
+
+    public:
+    // Return texture containing the glyph atlas
+    Qt3DRender::QAbstractTexture *texture() const;
+
+    /*
+     * Definition
+     */
+    private:
+    // Current text
+    QString text_;
+    // Anchor point for entity
+    MildredMetrics::AnchorPoint anchorPoint_{MildredMetrics::AnchorPoint::BottomLeft};
+    // Requested anchor position
+    QVector3D anchorPosition_{0.0, 0.0, 0.0};
+
+    private:
+    // Update translation
+    void updateTranslation();
+
+    public:
+    // Set text
+    void setText(const QString &text);
+    // Return current text
+    QString text() const;
+    // Set anchor point
+    void setAnchorPoint(MildredMetrics::AnchorPoint anchor);
+    // Set anchor position
+    void setAnchorPosition(QVector3D p);
+};
+} // namespace Mildred
@@ -0,0 +1,91 @@
+#include "entities/layercache.h"
+
+using namespace Mildred;
+
+/*
+ * LayerCacheImage
+ */
+
+LayerCacheImage::LayerCacheImage(Qt3DCore::QNode *parent) : Qt3DRender::QPaintedTextureImage(parent) {}
+
+//! Paint the image
+void LayerCacheImage::paint(QPainter *painter)
+{
+    if (paintFunction_)
+        paintFunction_(*painter);
+}
+
+//! Set function used to paint the image
+void LayerCacheImage::setPaintFunction(std::function<void(QPainter &)> paintFunction)
+{
+    paintFunction_ = std::move(paintFunction);
+}
+
+/*
+ * LayerCacheEntity
+ */
+
+//! Construct a new LayerCacheEntity
+/*!
+ * Creates a quad covering the entire viewport (its vertices are given directly in normalised device coordinates) and an empty
+ * texture to hold the cached layer.
+ */
+LayerCacheEntity::LayerCacheEntity(Qt3DCore::QNode *parent)
+    : Qt3DCore::QEntity(parent), geometry_(this), geometryRenderer_(this), vertexBuffer_(&geometry_),
+      vertexAttribute_(&geometry_)
+{
+    // Set up the quad vertices
+    const float vertices[] = {-1.0f, -1.0f, 0.0f, 1.0f, -1.0f, 0.0f, -1.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f};
+    vertexBuffer_.setData(QByteArray(reinterpret_cast<const char *>(vertices), sizeof(vertices)));
+    vertexAttribute_.setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+    vertexAttribute_.setVertexBaseType(Qt3DCore::QAttribute::Float);
+    vertexAttribute_.setVertexSize(3);
+    vertexAttribute_.setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    vertexAttribute_.setBuffer(&vertexBuffer_);
+    vertexAttribute_.setByteStride(3 * sizeof(float));
+    vertexAttribute_.setCount(4);
+    geometry_.addAttribute(&vertexAttribute_);
+
+    geometryRenderer_.setGeometry(&geometry_);
+    geometryRenderer_.setPrimitiveType(Qt3DRender::QGeometryRenderer::TriangleStrip);
+    addComponent(&geometryRenderer_);
+
+    // Create the texture - it maps exactly onto the viewport, so no filtering is required
+    texture_ = new Qt3DRender::QTexture2D(this);
+    texture_->setFormat(Qt3DRender::QAbstractTexture::RGBA8_UNorm);
+    texture_->setGenerateMipMaps(false);
+    texture_->setMinificationFilter(Qt3DRender::QAbstractTexture::Nearest);
+    texture_->setMagnificationFilter(Qt3DRender::QAbstractTexture::Nearest);
+    image_ = new LayerCacheImage(texture_);
+    texture_->addTextureImage(image_);
+}
+
+//! Set function used to paint the layer
+/*!
+ * Set the @param paintFunction used to paint the layer. The painter draws onto an image of the size given in setSize(), and
+ * the function is responsible for filling the entire image.
+ */
+void LayerCacheEntity::setPaintFunction(std::function<void(QPainter &)> paintFunction)
+{
+    image_->setPaintFunction(std::move(paintFunction));
+}
+
+//! Set size of the cached layer, in pixels
+/*!
+ * The size should match that of the render target, so that the layer maps onto it pixel-for-pixel. Changing the size causes
+ * the layer to be repainted.
+ */
+void LayerCacheEntity::setSize(QSize size)
+{
+    if (size == image_->size())
+        return;
+
+    texture_->setSize(size.width(), size.height());
+    image_->setSize(size);
+}
+
+//! Return texture containing the cached layer
+Qt3DRender::QAbstractTexture *LayerCacheEntity::texture() const { return texture_; }
+
+//! Repaint the cached layer
+void LayerCacheEntity::repaint() { image_->update(); }
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QPainter>
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QBuffer>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QGeometry>
+#include <Qt3DRender/QGeometryRenderer>
+#include <Qt3DRender/QPaintedTextureImage>
+#include <Qt3DRender/QTexture>
+#include <functional>
+
+namespace Mildred
+{
+//! LayerCacheImage is a texture image painted by a supplied function
+class LayerCacheImage : public Qt3DRender::QPaintedTextureImage
+{
+    public:
+    LayerCacheImage(Qt3DCore::QNode *parent = nullptr);
+    ~LayerCacheImage() override = default;
+
+    private:
+    // Function used to paint the image
+    std::function<void(QPainter &)> paintFunction_;
+
+    protected:
+    // Paint the image
+    void paint(QPainter *painter) override;
+
+    public:
+    // Set function used to paint the image
+    void setPaintFunction(std::function<void(QPainter &)> paintFunction);
+};
+
+//! LayerCacheEntity displays a cached, pre-rendered layer of the scene
+/*!
+ * LayerCacheEntity draws a texture covering the entire viewport, the contents of which are painted only when explicitly
+ * requested. It allows static parts of the scene to be drawn once and then composited cheaply in every subsequent frame. The
+ * entity requires a material with the ScreenQuad vertex shader and Texture fragment shader, to which the texture returned by
+ * texture() should be supplied as the "layerTexture" parameter.
+ */
+class LayerCacheEntity : public Qt3DCore::QEntity
+{
+    public:
+    LayerCacheEntity(Qt3DCore::QNode *parent = nullptr);
+    ~LayerCacheEntity() = default;
+
+    private:
+    // Quad geometry
+    Qt3DCore::QGeometry geometry_;
+    // Renderer for quad geometry
+    Qt3DRender::QGeometryRenderer geometryRenderer_;
+    // Buffer and attribute
+    Qt3DCore::QBuffer vertexBuffer_;
+    Qt3DCore::QAttribute vertexAttribute_;
+    // Texture containing the cached layer, and its image
+    Qt3DRender::QTexture2D *texture_{nullptr};
+    LayerCacheImage *image_{nullptr};
+
+    public:
+    // Set function used to paint the layer
+    void setPaintFunction(std::function<void(QPainter &)> paintFunction);
+    // Set size of the cached layer, in pixels
+    void setSize(QSize size);
+    // Return texture containing the cached layer
+    Qt3DRender::QAbstractTexture *texture() const;
+    // Repaint the cached layer
+    void repaint();
+};
+} // namespace Mildred
@@ -1,4 +1,5 @@
 #include "entities/line.h"
+#include "material.h"
 
 using namespace Mildred;
 
@@ -10,7 +11,7 @@ using namespace Mildred;
 LineEntity::LineEntity(Qt3DCore::QNode *parent, Qt3DRender::QGeometryRenderer::PrimitiveType primitiveType)
     : Qt3DCore::QEntity(parent), geometry_(this), geometryRenderer_(this), vertexBuffer_(&geometry_),
       vertexAttribute_(&geometry_), indexBuffer_(&geometry_), indexAttribute_(&geometry_), colourBuffer_(&geometry_),
-      colourAttribute_(&geometry_)
+      colourAttribute_(&geometry_), primitiveType_(primitiveType)
 {
 
     // Set up the vertex attribute
@@ -54,6 +55,139 @@ LineEntity::LineEntity(Qt3DCore::QNode *parent, Qt3DRender::QGeometryRenderer::P
     addComponent(&geometryRenderer_);
 }
 
+/*
+ * Instanced Segments
+ */
+
+//! Return whether the entity's material requires lines to be supplied as instanced segments
+bool LineEntity::drawsInstancedLines() const
+{
+    auto materials = componentsOfType<RenderableMaterial>();
+    return !materials.isEmpty() && materials.first()->drawsInstancedLines();
+}
+
+//! Create instanced segment geometry
+/*!
+ * Create the geometry used when drawing instanced segments. A static four-vertex buffer defines the corners of a unit quad,
+ * drawn as a triangle strip, while a per-instance buffer provides the end points and colours of each segment.
+ */
+void LineEntity::createInstancedGeometry()
+{
+    instancedGeometry_ = new Qt3DCore::QGeometry(this);
+
+    // Quad corners - position along the segment (0 or 1) and side of the line (-1 or 1)
+    auto *cornerBuffer = new Qt3DCore::QBuffer(instancedGeometry_);
+    const float corners[] = {0.0f, 1.0f, 0.0f, -1.0f, 1.0f, 1.0f, 1.0f, -1.0f};
+    cornerBuffer->setData(QByteArray(reinterpret_cast<const char *>(corners), sizeof(corners)));
+    auto *cornerAttribute = new Qt3DCore::QAttribute(instancedGeometry_);
+    cornerAttribute->setName(QStringLiteral("quadCorner"));
+    cornerAttribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+    cornerAttribute->setVertexSize(2);
+    cornerAttribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    cornerAttribute->setBuffer(cornerBuffer);
+    cornerAttribute->setByteStride(2 * sizeof(float));
+    cornerAttribute->setCount(4);
+    instancedGeometry_->addAttribute(cornerAttribute);
+
+    // Segment data - start position and colour, then end position and colour
+    segmentBuffer_ = new Qt3DCore::QBuffer(instancedGeometry_);
+    auto offset = 0;
+    for (auto &&[name, size] : std::vector<std::pair<QString, int>>{
+             {"segmentStart", 3}, {"segmentStartColor", 4}, {"segmentEnd", 3}, {"segmentEndColor", 4}})
+    {
+        auto *attribute = new Qt3DCore::QAttribute(instancedGeometry_);
+        attribute->setName(name);
+        attribute->setVertexBaseType(Qt3DCore::QAttribute::Float);
+        attribute->setVertexSize(size);
+        attribute->setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+        attribute->setBuffer(segmentBuffer_);
+        attribute->setByteOffset(offset * sizeof(float));
+        attribute->setByteStride(14 * sizeof(float));
+        attribute->setDivisor(1);
+        instancedGeometry_->addAttribute(attribute);
+        offset += size;
+    }
+}
+
+//! Set the geometry to draw
+/*!
+ * Switch the renderer between the standard line geometry and (if @param instanced) the instanced segment geometry containing
+ * @param nSegments segments.
+ */
+void LineEntity::setActiveGeometry(bool instanced, int nSegments)
+{
+    if (instanced)
+    {
+        geometryRenderer_.setGeometry(instancedGeometry_);
+        geometryRenderer_.setPrimitiveType(Qt3DRender::QGeometryRenderer::TriangleStrip);
+        geometryRenderer_.setPrimitiveRestartEnabled(false);
+        geometryRenderer_.setVertexCount(4);
+        geometryRenderer_.setInstanceCount(nSegments);
+    }
+    else
+    {
+        geometryRenderer_.setGeometry(&geometry_);
+        geometryRenderer_.setPrimitiveType(primitiveType_);
+        geometryRenderer_.setPrimitiveRestartEnabled(true);
+        geometryRenderer_.setVertexCount(0);
+        geometryRenderer_.setInstanceCount(1);
+    }
+}
+
+//! Finalise instanced segment geometry from cached data
+/*!
+ * Convert the cached vertices and indices into individual line segments according to the entity's primitive type, honouring
+ * primitive restarts, and store them in the per-instance segment buffer. The standard vertex buffer is not rewritten, so its
+ * count is zeroed to stop other entities (e.g. selections) indexing into stale positions.
+ */
+void LineEntity::finaliseInstanced()
+{
+    if (!instancedGeometry_)
+        createInstancedGeometry();
+
+    auto hasColours = cachedVertices_.size() == cachedVertexColours_.size();
+    const auto restartIndex = static_cast<unsigned int>(-1);
+
+    // Determine segments as pairs of vertex indices
+    std::vector<std::pair<unsigned int, unsigned int>> segments;
+    if (primitiveType_ == Qt3DRender::QGeometryRenderer::Lines)
+    {
+        for (std::size_t n = 0; n + 1 < cachedIndices_.size(); n += 2)
+            segments.emplace_back(cachedIndices_[n], cachedIndices_[n + 1]);
+    }
+    else
+    {
+        for (std::size_t n = 0; n + 1 < cachedIndices_.size(); ++n)
+            if (cachedIndices_[n] != restartIndex && cachedIndices_[n + 1] != restartIndex)
+                segments.emplace_back(cachedIndices_[n], cachedIndices_[n + 1]);
+    }
+
+    // Write segment data
+    QByteArray segmentBytes;
+    segmentBytes.resize(segments.size() * 14 * sizeof(float));
+    auto *data = reinterpret_cast<float *>(segmentBytes.data());
+    auto writeVertex = [&](unsigned int i) {
+        const auto &v = cachedVertices_[i];
+        *data++ = v.x();
+        *data++ = v.y();
+        *data++ = v.z();
+        auto c = hasColours ? cachedVertexColours_[i] : QColor(Qt::black);
+        *data++ = c.redF();
+        *data++ = c.greenF();
+        *data++ = c.blueF();
+        *data++ = c.alphaF();
+    };
+    for (auto &&[i, j] : segments)
+    {
+        writeVertex(i);
+        writeVertex(j);
+    }
+    segmentBuffer_->setData(segmentBytes);
+    vertexAttribute_.setCount(0);
+
+    setActiveGeometry(true, segments.size());
+}
+
 /*
  * Convenience Functions
  */
@@ -116,9 +250,22 @@ void LineEntity::setBasicIndices()
  *
  * Once the geometry is constructed the cached vertex and index data is cleared, permitting new data to be added and the entity
  * to be recreated again at a later date.
+ *
+ * If the entity's material draws instanced lines, the data is instead converted to instanced segments.
  */
 void LineEntity::finalise()
 {
+    if (drawsInstancedLines())
+    {
+        finaliseInstanced();
+        cachedVertices_.clear();
+        cachedIndices_.clear();
+        cachedVertexColours_.clear();
+        return;
+    }
+
+    setActiveGeometry(false);
+
     // Convert vertex cache into a QByteArray
     QByteArray vertexBytes;
     vertexBytes.resize(cachedVertices_.size() * 3 * sizeof(float));
@@ -172,6 +319,7 @@ void LineEntity::finalise()
  */
 void LineEntity::clear()
 {
+    setActiveGeometry(false);
     vertexAttribute_.setCount(0);
     indexAttribute_.setCount(0);
     colourAttribute_.setCount(0);
@@ -179,3 +327,12 @@ void LineEntity::clear()
     cachedIndices_.clear();
     cachedVertexColours_.clear();
 }
+
+//! Return vertex buffer
+/*!
+ * Return the buffer containing the finalised (non-instanced) vertex positions, which may be shared with other geometry.
+ */
+Qt3DCore::QBuffer *LineEntity::vertexBuffer() { return &vertexBuffer_; }
+
+//! Return number of vertices in the vertex buffer
+int LineEntity::vertexCount() const { return vertexAttribute_.count(); }
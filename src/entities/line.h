@@ -10,6 +10,9 @@ namespace Mildred
 //! LineEntity represents a renderable lines / wireframe object
 /*!
  * LineEntity encapsulates the buffers and attributes necessary to provide a line-drawn QEntity for use in a Qt3D scenegraph.
+ *
+ * If the entity's material draws instanced lines, the geometry is instead supplied as one instance per line segment, each
+ * drawn as a quad.
  */
 class LineEntity : public Qt3DCore::QEntity
 {
@@ -30,6 +33,21 @@ class LineEntity : public Qt3DCore::QEntity
     Qt3DCore::QAttribute indexAttribute_;
     Qt3DCore::QBuffer colourBuffer_;
     Qt3DCore::QAttribute colourAttribute_;
+    // Primitive type used when not drawing instanced segments
+    Qt3DRender::QGeometryRenderer::PrimitiveType primitiveType_;
+    // Instanced segment geometry and buffer (created on first use)
+    Qt3DCore::QGeometry *instancedGeometry_{nullptr};
+    Qt3DCore::QBuffer *segmentBuffer_{nullptr};
+
+    private:
+    // Return whether the entity's material requires lines to be supplied as instanced segments
+    bool drawsInstancedLines() const;
+    // Create instanced segment geometry
+    void createInstancedGeometry();
+    // Set the geometry to draw
+    void setActiveGeometry(bool instanced, int nSegments = 0);
+    // Finalise instanced segment geometry from cached data
+    void finaliseInstanced();
 
     /*
      * Convenience Functions
@@ -56,5 +74,9 @@ class LineEntity : public Qt3DCore::QEntity
     void finalise();
     // Clear geometry
     void clear();
+    // Return vertex buffer
+    Qt3DCore::QBuffer *vertexBuffer();
+    // Return number of vertices in the vertex buffer
+    int vertexCount() const;
 };
 } // namespace Mildred
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "entities/subset.h"
+
+using namespace Mildred;
+
+//! Construct a new SubsetEntity
+/*!
+ * Creates an empty SubsetEntity, drawing points. The vertex attribute is attached to a source entity's vertex buffer when
+ * set() is called.
+ */
+SubsetEntity::SubsetEntity(Qt3DCore::QNode *parent)
+    : Qt3DCore::QEntity(parent), geometry_(this), geometryRenderer_(this), vertexBuffer_(&geometry_),
+      vertexAttribute_(&geometry_), indexBuffer_(&geometry_), indexAttribute_(&geometry_)
+{
+    // Set up the vertex attribute
+    vertexAttribute_.setName(Qt3DCore::QAttribute::defaultPositionAttributeName());
+    vertexAttribute_.setVertexBaseType(Qt3DCore::QAttribute::Float);
+    vertexAttribute_.setVertexSize(3);
+    vertexAttribute_.setAttributeType(Qt3DCore::QAttribute::VertexAttribute);
+    vertexAttribute_.setBuffer(&vertexBuffer_);
+    vertexAttribute_.setByteStride(3 * sizeof(float));
+    vertexAttribute_.setCount(0);
+
+    // Set up the index attribute
+    indexAttribute_.setVertexBaseType(Qt3DCore::QAttribute::UnsignedInt);
+    indexAttribute_.setAttributeType(Qt3DCore::QAttribute::IndexAttribute);
+    indexAttribute_.setBuffer(&indexBuffer_);
+    indexAttribute_.setCount(0);
+
+    // Set up geometry and renderer
+    geometry_.addAttribute(&vertexAttribute_);
+    geometry_.addAttribute(&indexAttribute_);
+
+    geometryRenderer_.setGeometry(&geometry_);
+    geometryRenderer_.setPrimitiveType(Qt3DRender::QGeometryRenderer::Points);
+
+    // Set up entity
+    addComponent(&geometryRenderer_);
+}
+
+//! Draw the specified vertices of the source entity
+/*!
+ * Draw the vertices of @param source given by @param indices, which must be valid for the source's current vertex data. Only
+ * the indices are uploaded - positions are read from the source's vertex buffer, and so follow any subsequent regeneration of
+ * the source provided its vertex count is unchanged.
+ */
+void SubsetEntity::set(LineEntity *source, const std::vector<int> &indices)
+{
+    vertexAttribute_.setBuffer(source->vertexBuffer());
+    vertexAttribute_.setCount(source->vertexCount());
+
+    QByteArray indexBytes;
+    indexBytes.resize(indices.size() * sizeof(unsigned int));
+    auto *data = reinterpret_cast<unsigned int *>(indexBytes.data());
+    for (const auto i : indices)
+        *data++ = i;
+    indexBuffer_.setData(indexBytes);
+    indexAttribute_.setCount(indices.size());
+}
+
+//! Draw the specified vertices
+/*!
+ * Draw the supplied @param vertices, which are copied to a local buffer. This is used when no suitable source entity exists.
+ */
+void SubsetEntity::set(const std::vector<QVector3D> &vertices)
+{
+    QByteArray vertexBytes;
+    vertexBytes.resize(vertices.size() * 3 * sizeof(float));
+    auto *data = reinterpret_cast<float *>(vertexBytes.data());
+    for (const auto &v : vertices)
+    {
+        *data++ = v.x();
+        *data++ = v.y();
+        *data++ = v.z();
+    }
+    vertexBuffer_.setData(vertexBytes);
+    vertexAttribute_.setBuffer(&vertexBuffer_);
+    vertexAttribute_.setCount(vertices.size());
+
+    QByteArray indexBytes;
+    indexBytes.resize(vertices.size() * sizeof(unsigned int));
+    auto *indices = reinterpret_cast<unsigned int *>(indexBytes.data());
+    for (auto n = 0u; n < vertices.size(); ++n)
+        *indices++ = n;
+    indexBuffer_.setData(indexBytes);
+    indexAttribute_.setCount(vertices.size());
+}
+
+//! Clear geometry
+void SubsetEntity::clear()
+{
+    vertexAttribute_.setCount(0);
+    indexAttribute_.setCount(0);
+}
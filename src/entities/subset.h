@@ -0,0 +1,44 @@
+#pragma once
+
+#include "entities/line.h"
+#include <Qt3DCore/QAttribute>
+#include <Qt3DCore/QBuffer>
+#include <Qt3DCore/QEntity>
+#include <Qt3DCore/QGeometry>
+#include <Qt3DRender/QGeometryRenderer>
+
+namespace Mildred
+{
+//! SubsetEntity draws a subset of the vertices of another entity as points
+/*!
+ * SubsetEntity renders selected vertices of a source @class LineEntity, identified by an index buffer, reading positions
+ * directly from the source's vertex buffer so that no geometry is duplicated. If no source is available, positions may instead
+ * be supplied explicitly. The entity requires a material with the Point vertex shader.
+ */
+class SubsetEntity : public Qt3DCore::QEntity
+{
+    public:
+    SubsetEntity(Qt3DCore::QNode *parent = nullptr);
+    ~SubsetEntity() = default;
+
+    private:
+    // Point geometry
+    Qt3DCore::QGeometry geometry_;
+    // Renderer for point geometry
+    Qt3DRender::QGeometryRenderer geometryRenderer_;
+    // Local vertex buffer, used if no source entity is available
+    Qt3DCore::QBuffer vertexBuffer_;
+    // Buffers and attributes
+    Qt3DCore::QAttribute vertexAttribute_;
+    Qt3DCore::QBuffer indexBuffer_;
+    Qt3DCore::QAttribute indexAttribute_;
+
+    public:
+    // Draw the specified vertices of the source entity
+    void set(LineEntity *source, const std::vector<int> &indices);
+    // Draw the specified vertices
+    void set(const std::vector<QVector3D> &vertices);
+    // Clear geometry
+    void clear();
+};
+} // namespace Mildred
@@ -4,64 +4,272 @@
 #include <Qt3DRender/QClearBuffers>
 #include <Qt3DRender/QClipPlane>
 #include <Qt3DRender/QCullFace>
+#include <Qt3DRender/QDepthTest>
+#include <Qt3DRender/QLayerFilter>
+#include <Qt3DRender/QNoDepthMask>
+#include <Qt3DRender/QNoDraw>
+#include <Qt3DRender/QRenderCapture>
 #include <Qt3DRender/QRenderSettings>
 #include <Qt3DRender/QRenderStateSet>
 #include <Qt3DRender/QRenderSurfaceSelector>
+#include <Qt3DRender/QRenderTargetOutput>
+#include <Qt3DRender/QRenderTargetSelector>
+#include <Qt3DRender/QScissorTest>
 #include <Qt3DRender/QViewport>
+#include <vector>
 
 using namespace Mildred;
 
-//! Create the framegraph
+//! Create main rendering branch beneath the specified node
 /*!
- * Create a suitable framegraph for the supplied QRenderSettings @param parent and specified @param surface.
- * @param camera
- *
- * The framegraph is constructed with the following structure:
+ * Create the main rendering branch of the framegraph as a child of @param parent, viewing the scene through @param camera.
+ * Entities tagged with the supplied @param layers are drawn separately from the rest of the scene in the flat pipeline. The
+ * branch is constructed with the following structure:
  *
- *        [QRenderSettings]         Parent of first framegraph node
- *               |
- *        QSurfaceSelector          Sets the target surface for the renderer
+ *           [parent]
  *               |
  *           QViewport              Defines the viewport on the target surface
  *               |
- *         QClearBuffers            Sets the targets to clear and the default attributes to clear to
- *               |
  *        QCameraSelector           Selects an existing camera to view the scenegraph
+ *          |          |
+ *   volumeBranch_  flatBranch_     Full 3D and flat (2D) pipelines, only one of which is enabled at any time
+ *
+ * The volume branch clears colour and depth buffers and draws the whole scene (except the axes cache) with six clip planes
+ * enabled, relying on the clipped vertex shaders to restrict data to the data volume.
+ *
+ * The flat branch clears only the colour buffer and disables depth testing entirely. Rather than drawing the axes directly it
+ * draws the axes cache - a pre-rendered texture of the axes which is only updated when they change. Remaining scene objects
+ * are then drawn, followed by the data with a scissor test restricting it to the data volume.
+ *
+ * Each branch ends in its own QRenderCapture, which is always the last leaf drawn so that captures contain the complete frame.
  */
-void MildredFrameGraph::create(Qt3DRender::QRenderSettings *parent, Qt3DExtras::Qt3DWindow *surface,
-                               Qt3DRender::QCamera *camera)
+void MildredFrameGraph::createRenderBranch(Qt3DRender::QFrameGraphNode *parent, Qt3DRender::QCamera *camera,
+                                           const Layers &layers)
 {
-    // Set our rendering surface
-    auto *surfaceSelector = new Qt3DRender::QRenderSurfaceSelector(parent);
-    surfaceSelector->setSurface(surface);
-
     // Define a viewport to cover the entire surface
-    auto *viewport = new Qt3DRender::QViewport(surfaceSelector);
+    auto *viewport = new Qt3DRender::QViewport(parent);
     viewport->setNormalizedRect({0.0, 0.0, 1.0, 1.0});
 
-    // Clear to background colour
-    auto *clearBuffers = new Qt3DRender::QClearBuffers(viewport);
-    clearBuffers->setBuffers(Qt3DRender::QClearBuffers::ColorDepthBuffer);
-    clearBuffers->setClearColor(QColor(255, 255, 255, 255));
-
     // Set the camera to the one which was passed in
-    auto *cameraSelector = new Qt3DRender::QCameraSelector(clearBuffers);
+    auto *cameraSelector = new Qt3DRender::QCameraSelector(viewport);
     cameraSelector->setCamera(camera);
 
-    // Create a render state set
-    auto *renderStateSet = new Qt3DRender::QRenderStateSet(cameraSelector);
+    // Create clear buffers node with no draw leaf
+    auto createClearBuffers = [](Qt3DRender::QFrameGraphNode *branchParent, Qt3DRender::QClearBuffers::BufferType buffers) {
+        auto *clearBuffers = new Qt3DRender::QClearBuffers(branchParent);
+        clearBuffers->setBuffers(buffers);
+        clearBuffers->setClearColor(QColor(255, 255, 255, 255));
+        new Qt3DRender::QNoDraw(clearBuffers);
+    };
+    // Create layer filter
+    auto createLayerFilter = [](Qt3DRender::QFrameGraphNode *branchParent, Qt3DRender::QLayerFilter::FilterMode mode,
+                                std::vector<Qt3DRender::QLayer *> filterLayers) {
+        auto *layerFilter = new Qt3DRender::QLayerFilter(branchParent);
+        for (auto *layer : filterLayers)
+            layerFilter->addLayer(layer);
+        layerFilter->setFilterMode(mode);
+        return layerFilter;
+    };
+    // Create flat render state set, with face culling, depth testing, and depth writing disabled
+    auto createFlatStateSet = [](Qt3DRender::QFrameGraphNode *branchParent) {
+        auto *renderStateSet = new Qt3DRender::QRenderStateSet(branchParent);
+        auto *cull = new Qt3DRender::QCullFace();
+        cull->setMode(Qt3DRender::QCullFace::NoCulling);
+        renderStateSet->addRenderState(cull);
+        auto *depthTest = new Qt3DRender::QDepthTest;
+        depthTest->setDepthFunction(Qt3DRender::QDepthTest::Always);
+        renderStateSet->addRenderState(depthTest);
+        renderStateSet->addRenderState(new Qt3DRender::QNoDepthMask);
+        return renderStateSet;
+    };
+
+    /*
+     * Volume (3D) Branch
+     */
+
+    volumeBranch_ = new Qt3DRender::QFrameGraphNode(cameraSelector);
+
+    // Clear to background colour
+    createClearBuffers(volumeBranch_, Qt3DRender::QClearBuffers::ColorDepthBuffer);
+
+    // Create a render state set, drawing everything except the axes cache
+    auto *volumeLayerFilter =
+        createLayerFilter(volumeBranch_, Qt3DRender::QLayerFilter::DiscardAnyMatchingLayers, {layers.axesCache});
+    auto *volumeStateSet = new Qt3DRender::QRenderStateSet(volumeLayerFilter);
     // -- Enable six clip planes for the data viewing volume
     for (auto n = 0; n < 6; ++n)
     {
         auto *cp = new Qt3DRender::QClipPlane;
         cp->setPlaneIndex(n);
         cp->setEnabled(true);
-        renderStateSet->addRenderState(cp);
+        volumeStateSet->addRenderState(cp);
     }
     auto *cull = new Qt3DRender::QCullFace();
     cull->setMode(Qt3DRender::QCullFace::NoCulling);
-    renderStateSet->addRenderState(cull);
+    volumeStateSet->addRenderState(cull);
+
+    // Add a render capture node so rendered frames can be requested
+    volumeRenderCapture_ = new Qt3DRender::QRenderCapture(volumeStateSet);
+
+    /*
+     * Flat (2D) Branch
+     */
+
+    flatBranch_ = new Qt3DRender::QFrameGraphNode(cameraSelector);
+    flatBranch_->setEnabled(false);
+
+    // Clear to background colour - no depth buffer is required
+    createClearBuffers(flatBranch_, Qt3DRender::QClearBuffers::ColorBuffer);
+
+    // Draw the axes cache, then everything except axes and data, then data
+    createFlatStateSet(createLayerFilter(flatBranch_, Qt3DRender::QLayerFilter::AcceptAnyMatchingLayers, {layers.axesCache}));
+    createFlatStateSet(createLayerFilter(flatBranch_, Qt3DRender::QLayerFilter::DiscardAnyMatchingLayers,
+                                         {layers.axesCache, layers.axes, layers.data}));
+    auto *flatDataStateSet =
+        createFlatStateSet(createLayerFilter(flatBranch_, Qt3DRender::QLayerFilter::AcceptAnyMatchingLayers, {layers.data}));
+
+    // -- Clip data to the data volume with a scissor rectangle
+    dataScissorTest_ = new Qt3DRender::QScissorTest;
+    flatDataStateSet->addRenderState(dataScissorTest_);
+
+    // Add a render capture node so rendered frames can be requested
+    flatRenderCapture_ = new Qt3DRender::QRenderCapture(flatDataStateSet);
+}
+
+//! Create the framegraph
+/*!
+ * Create a suitable framegraph for the supplied QRenderSettings @param parent and specified @param surface, viewing the scene
+ * through @param camera. Entities must be tagged with the supplied @param layers as appropriate.
+ *
+ * The framegraph is constructed with the following structure:
+ *
+ *        [QRenderSettings]         Parent of first framegraph node
+ *               |
+ *        QSurfaceSelector          Sets the target surface for the renderer
+ *               |
+ *        [Render Branch]           Main rendering branch (see createRenderBranch())
+ */
+void MildredFrameGraph::create(Qt3DRender::QRenderSettings *parent, Qt3DExtras::Qt3DWindow *surface,
+                               Qt3DRender::QCamera *camera, const Layers &layers)
+{
+    // Set our rendering surface
+    surfaceSelector_ = new Qt3DRender::QRenderSurfaceSelector(parent);
+    surfaceSelector_->setSurface(surface);
+
+    createRenderBranch(surfaceSelector_, camera, layers);
 
     // Finally, set the active framegraph of the QRenderSettings to the top node of our framegraph
-    parent->setActiveFrameGraph(surfaceSelector);
+    parent->setActiveFrameGraph(surfaceSelector_);
+
+    renderSettings_ = parent;
+}
+
+//! Create and attach framegraph rendering to an offscreen target
+/*!
+ * Create a framegraph for the supplied QRenderSettings @param parent which renders into textures rather than to a window. The
+ * offscreen @param surface is required only to provide a valid context for the renderer. Rendered frames are retrieved through
+ * the render capture node, and the size of the target is set with setTargetSize().
+ *
+ * The framegraph is constructed with the following structure:
+ *
+ *        [QRenderSettings]         Parent of first framegraph node
+ *               |
+ *        QSurfaceSelector          Sets the (offscreen) surface for the renderer
+ *               |
+ *      QRenderTargetSelector       Directs output to colour and depth textures
+ *               |
+ *        [Render Branch]           Main rendering branch (see createRenderBranch())
+ */
+void MildredFrameGraph::createOffscreen(Qt3DRender::QRenderSettings *parent, QOffscreenSurface *surface,
+                                        Qt3DRender::QCamera *camera, const Layers &layers)
+{
+    // Set our rendering surface
+    surfaceSelector_ = new Qt3DRender::QRenderSurfaceSelector(parent);
+    surfaceSelector_->setSurface(surface);
+
+    // Create the render target
+    renderTarget_ = new Qt3DRender::QRenderTarget(surfaceSelector_);
+    colourTexture_ = new Qt3DRender::QTexture2D(renderTarget_);
+    colourTexture_->setFormat(Qt3DRender::QAbstractTexture::RGBA8_UNorm);
+    colourTexture_->setGenerateMipMaps(false);
+    auto *colourOutput = new Qt3DRender::QRenderTargetOutput(renderTarget_);
+    colourOutput->setAttachmentPoint(Qt3DRender::QRenderTargetOutput::Color0);
+    colourOutput->setTexture(colourTexture_);
+    renderTarget_->addOutput(colourOutput);
+    depthTexture_ = new Qt3DRender::QTexture2D(renderTarget_);
+    depthTexture_->setFormat(Qt3DRender::QAbstractTexture::D24);
+    depthTexture_->setGenerateMipMaps(false);
+    auto *depthOutput = new Qt3DRender::QRenderTargetOutput(renderTarget_);
+    depthOutput->setAttachmentPoint(Qt3DRender::QRenderTargetOutput::Depth);
+    depthOutput->setTexture(depthTexture_);
+    renderTarget_->addOutput(depthOutput);
+
+    auto *renderTargetSelector = new Qt3DRender::QRenderTargetSelector(surfaceSelector_);
+    renderTargetSelector->setTarget(renderTarget_);
+
+    createRenderBranch(renderTargetSelector, camera, layers);
+
+    // Finally, set the active framegraph of the QRenderSettings to the top node of our framegraph
+    parent->setActiveFrameGraph(surfaceSelector_);
+
+    renderSettings_ = parent;
+}
+
+//! Return whether the framegraph renders to an offscreen target
+bool MildredFrameGraph::isOffscreen() const { return renderTarget_ != nullptr; }
+
+//! Set size of the offscreen render target
+void MildredFrameGraph::setTargetSize(QSize size)
+{
+    assert(renderTarget_);
+
+    colourTexture_->setSize(size.width(), size.height());
+    depthTexture_->setSize(size.width(), size.height());
+    surfaceSelector_->setExternalRenderTargetSize(size);
+}
+
+//! Set whether the flat (2D) pipeline is used
+/*!
+ * Select between the flat (2D) pipeline (@param flat = true) and the full 3D pipeline. Data materials must be switched to use
+ * the flat shaders at the same time, since the flat pipeline performs no clipping in the vertex stage.
+ */
+void MildredFrameGraph::setFlat(bool flat)
+{
+    assert(volumeBranch_ && flatBranch_);
+    volumeBranch_->setEnabled(!flat);
+    flatBranch_->setEnabled(flat);
+}
+
+//! Return whether the flat (2D) pipeline is used
+bool MildredFrameGraph::isFlat() const { return flatBranch_ && flatBranch_->isEnabled(); }
+
+//! Set scissor rectangle used to clip data in the flat pipeline
+/*!
+ * Set the scissor rectangle, in pixels on the render target with its origin at the bottom-left corner, outside of which data
+ * is not drawn by the flat pipeline.
+ */
+void MildredFrameGraph::setDataScissorRect(QRect rect)
+{
+    assert(dataScissorTest_);
+    dataScissorTest_->setLeft(rect.x());
+    dataScissorTest_->setBottom(rect.y());
+    dataScissorTest_->setWidth(rect.width());
+    dataScissorTest_->setHeight(rect.height());
+}
+
+//! Return render capture node for the active pipeline
+Qt3DRender::QRenderCapture *MildredFrameGraph::renderCapture() const
+{
+    return isFlat() ? flatRenderCapture_ : volumeRenderCapture_;
+}
+
+//! Set whether the framegraph produces any output
+/*!
+ * Disabling the framegraph prevents the renderer from generating any render views from it, so no draw calls are issued until
+ * it is enabled again.
+ */
+void MildredFrameGraph::setEnabled(bool enabled)
+{
+    assert(surfaceSelector_);
+    surfaceSelector_->setEnabled(enabled);
 }
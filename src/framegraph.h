@@ -1,9 +1,16 @@
 #pragma once
 
+#include <QOffscreenSurface>
 #include <QWidget>
 #include <Qt3DExtras/Qt3DWindow>
 #include <Qt3DRender/QCamera>
+#include <Qt3DRender/QLayer>
+#include <Qt3DRender/QRenderCapture>
 #include <Qt3DRender/QRenderSettings>
+#include <Qt3DRender/QRenderSurfaceSelector>
+#include <Qt3DRender/QRenderTarget>
+#include <Qt3DRender/QScissorTest>
+#include <Qt3DRender/QTexture>
 
 namespace Mildred
 {
@@ -13,6 +20,16 @@ class MildredFrameGraph
     public:
     MildredFrameGraph() = default;
     ~MildredFrameGraph() = default;
+    // Layers identifying entities drawn separately in the flat pipeline
+    struct Layers
+    {
+        // Data entities
+        Qt3DRender::QLayer *data{nullptr};
+        // Axes entities
+        Qt3DRender::QLayer *axes{nullptr};
+        // Cached (pre-rendered) axes
+        Qt3DRender::QLayer *axesCache{nullptr};
+    };
 
     /*
      * Qt3D Objects
@@ -20,9 +37,42 @@ class MildredFrameGraph
     private:
     // Parent QRenderSettings
     Qt3DRender::QRenderSettings *renderSettings_{nullptr};
+    // Top node of the framegraph
+    Qt3DRender::QRenderSurfaceSelector *surfaceSelector_{nullptr};
+    // Branches implementing the full 3D and flat (2D) pipelines
+    Qt3DRender::QFrameGraphNode *volumeBranch_{nullptr}, *flatBranch_{nullptr};
+    // Render capture nodes for each branch
+    Qt3DRender::QRenderCapture *volumeRenderCapture_{nullptr}, *flatRenderCapture_{nullptr};
+    // Scissor test clipping data in the flat pipeline
+    Qt3DRender::QScissorTest *dataScissorTest_{nullptr};
+    // Offscreen render target and its attachments (offscreen framegraph only)
+    Qt3DRender::QRenderTarget *renderTarget_{nullptr};
+    Qt3DRender::QTexture2D *colourTexture_{nullptr}, *depthTexture_{nullptr};
+
+    private:
+    // Create main rendering branch beneath the specified node
+    void createRenderBranch(Qt3DRender::QFrameGraphNode *parent, Qt3DRender::QCamera *camera, const Layers &layers);
 
     public:
     // Create and attach framegraph
-    void create(Qt3DRender::QRenderSettings *parent, Qt3DExtras::Qt3DWindow *surface, Qt3DRender::QCamera *camera);
+    void create(Qt3DRender::QRenderSettings *parent, Qt3DExtras::Qt3DWindow *surface, Qt3DRender::QCamera *camera,
+                const Layers &layers);
+    // Create and attach framegraph rendering to an offscreen target
+    void createOffscreen(Qt3DRender::QRenderSettings *parent, QOffscreenSurface *surface, Qt3DRender::QCamera *camera,
+                         const Layers &layers);
+    // Return whether the framegraph renders to an offscreen target
+    bool isOffscreen() const;
+    // Set size of the offscreen render target
+    void setTargetSize(QSize size);
+    // Set whether the flat (2D) pipeline is used
+    void setFlat(bool flat);
+    // Return whether the flat (2D) pipeline is used
+    bool isFlat() const;
+    // Set scissor rectangle used to clip data in the flat pipeline
+    void setDataScissorRect(QRect rect);
+    // Return render capture node for the active pipeline
+    Qt3DRender::QRenderCapture *renderCapture() const;
+    // Set whether the framegraph produces any output
+    void setEnabled(bool enabled);
 };
-} // namespace Mildred
\ No newline at end of file
+} // namespace Mildred
@@ -0,0 +1,308 @@
+#include "io/columncache.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using namespace Mildred;
+
+//! Open the specified cache file
+/*!
+ * Map @param fileName and read its header, level table, and chunk table. No data are read until accessed. An exception is
+ * thrown if the file is not a cache file, is of an unsupported format version, or is inconsistent with its header.
+ */
+ColumnCache::ColumnCache(const QString &fileName) : file_(fileName)
+{
+    auto *data = file_.data();
+    auto get = [data](std::size_t offset, auto &value) { std::memcpy(&value, data + offset, sizeof(value)); };
+
+    if (file_.size() < headerSize || std::memcmp(data, "MILDREDC", 8) != 0)
+    {
+        printf("File '%s' is not a Mildred cache file.\n", qPrintable(fileName));
+        throw(std::runtime_error("Invalid cache file.\n"));
+    }
+
+    std::uint32_t version, flags, nLevels;
+    std::int64_t xBase;
+    get(8, version);
+    if (version != formatVersion)
+    {
+        printf("Cache file '%s' has format version %u, but only version %u is supported.\n", qPrintable(fileName), version,
+               formatVersion);
+        throw(std::runtime_error("Unsupported cache file version.\n"));
+    }
+
+    // Header
+    std::uint64_t nPoints, chunkSize, nChunks;
+    get(12, flags);
+    get(16, nPoints);
+    get(24, chunkSize);
+    get(32, nChunks);
+    get(40, nLevels);
+    get(48, extrema_.xMinimum);
+    get(56, extrema_.xMaximum);
+    get(64, extrema_.valueMinimum);
+    get(72, extrema_.valueMaximum);
+    get(80, positiveMinima_.first);
+    get(88, positiveMinima_.second);
+    get(96, xBase);
+    nPoints_ = nPoints;
+    chunkSize_ = chunkSize;
+    nChunks_ = nChunks;
+    hasErrors_ = flags & 1;
+    ascending_ = flags & 2;
+    auto xType = flags & 4 ? DataColumn::ElementType::Int64 : DataColumn::ElementType::Float64;
+    chunkTableOffset_ = headerSize + std::size_t(nLevels) * tableEntrySize;
+    // -- Sizes are compared by division, so that corrupt counts can't overflow the checks
+    if (nLevels == 0 || chunkSize_ == 0 || nChunks_ != nPoints_ / chunkSize_ + (nPoints_ % chunkSize_ == 0 ? 0 : 1) ||
+        chunkTableOffset_ > file_.size() || nChunks_ > (file_.size() - chunkTableOffset_) / tableEntrySize)
+    {
+        printf("Cache file '%s' has an inconsistent header.\n", qPrintable(fileName));
+        throw(std::runtime_error("Corrupt cache file.\n"));
+    }
+
+    // Levels of detail
+    for (std::uint32_t n = 0; n < nLevels; ++n)
+    {
+        std::uint64_t bucketSize, nLevelPoints, offset;
+        get(headerSize + n * tableEntrySize, bucketSize);
+        get(headerSize + n * tableEntrySize + 8, nLevelPoints);
+        get(headerSize + n * tableEntrySize + 16, offset);
+        if (offset > file_.size() || nLevelPoints > (file_.size() - offset) / ((hasErrors_ ? 3 : 2) * sizeof(double)))
+        {
+            printf("Level %u in cache file '%s' extends beyond the end of the file.\n", n, qPrintable(fileName));
+            throw(std::runtime_error("Corrupt cache file.\n"));
+        }
+        auto arraySize = nLevelPoints * sizeof(double);
+
+        levels_.push_back({bucketSize, file_.column(xType, offset, std::nullopt, nLevelPoints).rebased(xBase),
+                           file_.column(DataColumn::ElementType::Float64, offset + arraySize, std::nullopt, nLevelPoints),
+                           hasErrors_ ? file_.column(DataColumn::ElementType::Float64, offset + 2 * arraySize, std::nullopt,
+                                                     nLevelPoints)
+                                      : DataColumn()});
+    }
+    if (levels_.front().bucketSize != 1 || levels_.front().x.size() != nPoints_)
+    {
+        printf("Cache file '%s' does not contain full-resolution data.\n", qPrintable(fileName));
+        throw(std::runtime_error("Corrupt cache file.\n"));
+    }
+}
+
+//! Write cache file for the supplied data
+/*!
+ * Write a cache file named @param fileName containing the supplied axis values @param x, data @param values, and (if not
+ * empty) @param errors, along with extrema for every @param chunkSize points and all levels of detail holding at least @c
+ * minimumLevelPoints points. Everything is calculated in a single pass through the data, written directly into the mapped
+ * output file, so the data need not fit in memory. Int64 axis values are written exactly, along with the base of @param x.
+ */
+void ColumnCache::write(const QString &fileName, const DataColumn &x, const DataColumn &values, const DataColumn &errors,
+                        std::size_t chunkSize)
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    printf("Cache files require a little-endian host, so can't write '%s'.\n", qPrintable(fileName));
+    throw(std::runtime_error("Cache files unsupported on big-endian host.\n"));
+#endif
+
+    auto nPoints = x.size();
+    auto hasErrors = !errors.empty();
+    auto integerX = x.elementType() == DataColumn::ElementType::Int64;
+    if (values.size() != nPoints || (hasErrors && errors.size() != nPoints))
+    {
+        printf("Irregular vector sizes provided (%zu (x) vs %zu (y) vs %zu (errors)) so can't write cache file.\n", nPoints,
+               values.size(), errors.size());
+        throw(std::runtime_error("Irregular vector sizes for cache file.\n"));
+    }
+    chunkSize = std::max(chunkSize, std::size_t(1));
+    auto nChunks = (nPoints + chunkSize - 1) / chunkSize;
+
+    // Determine levels of detail (bucket size and number of points), and the layout of the file
+    std::vector<std::pair<std::size_t, std::size_t>> levels{{1, nPoints}};
+    for (auto bucketSize = levelFactor; 4 * ((nPoints + bucketSize - 1) / bucketSize) >= minimumLevelPoints;
+         bucketSize *= levelFactor)
+        levels.emplace_back(bucketSize, 4 * ((nPoints + bucketSize - 1) / bucketSize));
+    auto chunkTableOffset = headerSize + levels.size() * tableEntrySize;
+    std::vector<std::size_t> levelOffsets;
+    auto size = chunkTableOffset + nChunks * tableEntrySize;
+    for (auto &&[bucketSize, nLevelPoints] : levels)
+    {
+        levelOffsets.push_back(size);
+        size += (hasErrors ? 3 : 2) * nLevelPoints * sizeof(double);
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate) || !file.resize(size))
+    {
+        printf("Failed to create cache file '%s' (%s).\n", qPrintable(fileName), qPrintable(file.errorString()));
+        throw(std::runtime_error("Failed to create cache file.\n"));
+    }
+    auto *data = file.map(0, size);
+    if (!data)
+    {
+        printf("Failed to map cache file '%s' (%s).\n", qPrintable(fileName), qPrintable(file.errorString()));
+        throw(std::runtime_error("Failed to map cache file.\n"));
+    }
+    auto put = [data](std::size_t offset, auto value) { std::memcpy(data + offset, &value, sizeof(value)); };
+
+    // Point retained at a level of detail
+    struct LevelPoint
+    {
+        std::size_t index;
+        std::int64_t xInteger;
+        double x, value, error;
+    };
+    auto putPoint = [&](int level, std::size_t index, const LevelPoint &p) {
+        auto arraySize = levels[level].second * sizeof(double);
+        if (integerX)
+            put(levelOffsets[level] + index * sizeof(double), p.xInteger);
+        else
+            put(levelOffsets[level] + index * sizeof(double), p.x);
+        put(levelOffsets[level] + arraySize + index * sizeof(double), p.value);
+        if (hasErrors)
+            put(levelOffsets[level] + 2 * arraySize + index * sizeof(double), p.error);
+    };
+
+    // Bucket of points at a level of detail
+    struct Bucket
+    {
+        LevelPoint first, minimum, maximum, last;
+    };
+    std::vector<Bucket> buckets(levels.size());
+
+    const auto infinity = std::numeric_limits<double>::infinity();
+    Extrema extrema{infinity, -infinity, infinity, -infinity}, chunk{};
+    std::pair<double, double> positiveMinima{infinity, infinity};
+    auto ascending = true;
+    auto lastX = -infinity;
+    for (std::size_t n = 0; n < nPoints; ++n)
+    {
+        LevelPoint p{n, integerX ? x.integerValue(n) : 0, x[n], values[n], hasErrors ? errors[n] : 0.0};
+        putPoint(0, n, p);
+
+        // Extrema
+        if (!(p.x >= lastX))
+            ascending = false;
+        lastX = p.x;
+        if (n % chunkSize == 0)
+            chunk = {infinity, -infinity, infinity, -infinity};
+        auto lower = p.value - p.error, upper = p.value + p.error;
+        for (auto *range : {&extrema, &chunk})
+        {
+            range->xMinimum = std::min(range->xMinimum, p.x);
+            range->xMaximum = std::max(range->xMaximum, p.x);
+            range->valueMinimum = std::min(range->valueMinimum, lower);
+            range->valueMaximum = std::max(range->valueMaximum, upper);
+        }
+        if (p.x > 0.0)
+            positiveMinima.first = std::min(positiveMinima.first, p.x);
+        for (auto v : {lower, upper})
+            if (v > 0.0)
+                positiveMinima.second = std::min(positiveMinima.second, v);
+        if ((n + 1) % chunkSize == 0 || n + 1 == nPoints)
+        {
+            auto offset = chunkTableOffset + (n / chunkSize) * tableEntrySize;
+            put(offset, chunk.xMinimum);
+            put(offset + 8, chunk.xMaximum);
+            put(offset + 16, chunk.valueMinimum);
+            put(offset + 24, chunk.valueMaximum);
+        }
+
+        // Levels of detail - retain the first, minimum, maximum, and last points of each bucket, in their original order
+        for (auto level = 1; level < int(levels.size()); ++level)
+        {
+            auto bucketSize = levels[level].first;
+            auto &bucket = buckets[level];
+            if (n % bucketSize == 0)
+                bucket = {p, p, p, p};
+            else
+            {
+                if (p.value < bucket.minimum.value || std::isnan(bucket.minimum.value))
+                    bucket.minimum = p;
+                if (p.value > bucket.maximum.value || std::isnan(bucket.maximum.value))
+                    bucket.maximum = p;
+                bucket.last = p;
+            }
+
+            if ((n + 1) % bucketSize == 0 || n + 1 == nPoints)
+            {
+                std::array<LevelPoint, 4> points{bucket.first, bucket.minimum, bucket.maximum, bucket.last};
+                std::sort(points.begin(), points.end(), [](const auto &a, const auto &b) { return a.index < b.index; });
+                for (auto i = 0; i < 4; ++i)
+                    putPoint(level, (n / bucketSize) * 4 + i, points[i]);
+            }
+        }
+    }
+
+    // Header
+    std::memcpy(data, "MILDREDC", 8);
+    put(8, formatVersion);
+    put(12, std::uint32_t((hasErrors ? 1 : 0) | (ascending ? 2 : 0) | (integerX ? 4 : 0)));
+    put(16, std::uint64_t(nPoints));
+    put(24, std::uint64_t(chunkSize));
+    put(32, std::uint64_t(nChunks));
+    put(40, std::uint32_t(levels.size()));
+    put(48, extrema.xMinimum);
+    put(56, extrema.xMaximum);
+    put(64, extrema.valueMinimum);
+    put(72, extrema.valueMaximum);
+    put(80, std::isinf(positiveMinima.first) ? 0.0 : positiveMinima.first);
+    put(88, std::isinf(positiveMinima.second) ? 0.0 : positiveMinima.second);
+    put(96, std::int64_t(integerX ? x.base() : 0));
+
+    // Level table
+    for (auto n = 0; n < int(levels.size()); ++n)
+    {
+        put(headerSize + n * tableEntrySize, std::uint64_t(levels[n].first));
+        put(headerSize + n * tableEntrySize + 8, std::uint64_t(levels[n].second));
+        put(headerSize + n * tableEntrySize + 16, std::uint64_t(levelOffsets[n]));
+    }
+
+    file.unmap(data);
+    file.close();
+}
+
+//! Return number of full-resolution points
+std::size_t ColumnCache::nPoints() const { return nPoints_; }
+
+//! Return whether errors are present
+bool ColumnCache::hasErrors() const { return hasErrors_; }
+
+//! Return whether axis values are in ascending order
+bool ColumnCache::isAscending() const { return ascending_; }
+
+//! Return extrema of all data (including errors)
+const ColumnCache::Extrema &ColumnCache::extrema() const { return extrema_; }
+
+//! Return minimum positive axis and data values (or zero if there are none)
+std::pair<double, double> ColumnCache::positiveMinima() const { return positiveMinima_; }
+
+//! Return number of points per chunk
+std::size_t ColumnCache::chunkSize() const { return chunkSize_; }
+
+//! Return number of chunks
+std::size_t ColumnCache::nChunks() const { return nChunks_; }
+
+//! Return extrema of the specified chunk (including errors)
+/*!
+ * Return the extrema of the points in @param chunk (i.e. points chunk * chunkSize() onwards), allowing extrema over any range
+ * of points to be found by reading only the partial chunks at either end of the range.
+ */
+ColumnCache::Extrema ColumnCache::chunkExtrema(std::size_t chunk) const
+{
+    if (chunk >= nChunks_)
+    {
+        printf("Chunk index %zu out of range for cache with %zu chunks.\n", chunk, nChunks_);
+        throw(std::runtime_error("Cache chunk index out of range.\n"));
+    }
+
+    Extrema extrema;
+    std::memcpy(&extrema, file_.data() + chunkTableOffset_ + chunk * tableEntrySize, sizeof(Extrema));
+    return extrema;
+}
+
+//! Return number of levels of detail (including the full-resolution data)
+int ColumnCache::nLevels() const { return int(levels_.size()); }
+
+//! Return specified level of detail
+const ColumnCache::Level &ColumnCache::level(int index) const { return levels_.at(index); }
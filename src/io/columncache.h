@@ -0,0 +1,105 @@
+#pragma once
+
+#include "io/mappedfile.h"
+#include <cstdint>
+#include <vector>
+
+namespace Mildred
+{
+//! ColumnCache provides a memory-mapped, multi-resolution cache of one-dimensional data
+/*!
+ * The @class ColumnCache class reads cache files written by write(), which store one-dimensional data (axis values, data
+ * values, and optional errors) together with everything otherwise recomputed whenever the data are loaded - the overall data
+ * extrema, the extrema of every fixed-size chunk of points, and a pyramid of decimated levels of detail. Opening a cache reads
+ * only its header and tables, so large datasets may be re-opened instantly, and only those parts of the data (and levels)
+ * actually displayed are ever read from disk.
+ *
+ * Level zero holds the data at full resolution. Each subsequent level divides the points of the full-resolution data into
+ * buckets (each @c levelFactor times larger than those of the level before), retaining the first, last, minimum and maximum
+ * points of each bucket in their original order. Lines drawn from a level are therefore indistinguishable from those of the
+ * full data as long as each bucket spans no more than a single pixel.
+ *
+ * Data values and errors are stored little-endian as float64. Axis values are stored in the same way, except for 64-bit integer
+ * axis values (e.g. timestamps) which are stored as int64 along with the base of the supplied column, so that they are read
+ * back exactly. Extrema of such axis values are stored relative to that base. The file begins with a magic string and format
+ * version, and files of other versions are rejected.
+ */
+class ColumnCache
+{
+    public:
+    explicit ColumnCache(const QString &fileName);
+    ~ColumnCache() = default;
+
+    public:
+    // Format version written (and the only version read)
+    static constexpr std::uint32_t formatVersion = 2;
+    // Ratio of bucket sizes between successive levels of detail
+    static constexpr std::size_t levelFactor = 16;
+    // Minimum number of points for a level of detail to be stored
+    static constexpr std::size_t minimumLevelPoints = 4096;
+    // Extrema of a range of points
+    struct Extrema
+    {
+        double xMinimum, xMaximum, valueMinimum, valueMaximum;
+    };
+    // Level of detail
+    struct Level
+    {
+        // Number of full-resolution points represented by each group of four points
+        std::size_t bucketSize;
+        // Columns
+        DataColumn x, values, errors;
+    };
+
+    private:
+    // Size of file header, in bytes
+    static constexpr std::size_t headerSize = 128;
+    // Size of level and chunk table entries, in bytes
+    static constexpr std::size_t tableEntrySize = 32;
+    // Mapped file
+    MappedFile file_;
+    // Number of full-resolution points
+    std::size_t nPoints_{0};
+    // Number of points per chunk
+    std::size_t chunkSize_{0};
+    // Number of chunks
+    std::size_t nChunks_{0};
+    // Whether errors are present
+    bool hasErrors_{false};
+    // Whether axis values are in ascending order
+    bool ascending_{false};
+    // Extrema of all data (including errors)
+    Extrema extrema_{};
+    // Minimum positive axis and data values (or zero if there are none)
+    std::pair<double, double> positiveMinima_{0.0, 0.0};
+    // Byte offset of chunk extrema table
+    std::size_t chunkTableOffset_{0};
+    // Levels of detail, starting with the full-resolution data
+    std::vector<Level> levels_;
+
+    public:
+    // Write cache file for the supplied data
+    static void write(const QString &fileName, const DataColumn &x, const DataColumn &values, const DataColumn &errors = {},
+                      std::size_t chunkSize = 65536);
+    // Return number of full-resolution points
+    std::size_t nPoints() const;
+    // Return whether errors are present
+    bool hasErrors() const;
+    // Return whether axis values are in ascending order
+    bool isAscending() const;
+    // Return extrema of all data (including errors)
+    const Extrema &extrema() const;
+    // Return minimum positive axis and data values (or zero if there are none)
+    std::pair<double, double> positiveMinima() const;
+    // Return number of points per chunk
+    std::size_t chunkSize() const;
+    // Return number of chunks
+    std::size_t nChunks() const;
+    // Return extrema of the specified chunk (including errors)
+    Extrema chunkExtrema(std::size_t chunk) const;
+    // Return number of levels of detail (including the full-resolution data)
+    int nLevels() const;
+    // Return specified level of detail
+    const Level &level(int index) const;
+};
+} // namespace Mildred
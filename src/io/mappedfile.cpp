@@ -0,0 +1,73 @@
+#include "io/mappedfile.h"
+#include <QtEndian>
+#include <stdexcept>
+
+using namespace Mildred;
+
+//! Map the specified file
+/*!
+ * Open and map the whole of @param fileName into memory (read-only), throwing an exception if this is not possible.
+ */
+MappedFile::MappedFile(const QString &fileName)
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    printf("Memory-mapped columns require a little-endian host, so can't map '%s'.\n", qPrintable(fileName));
+    throw(std::runtime_error("Memory-mapped columns unsupported on big-endian host.\n"));
+#endif
+
+    file_ = std::make_shared<QFile>(fileName);
+    if (!file_->open(QIODevice::ReadOnly))
+    {
+        printf("Failed to open file '%s' for mapping.\n", qPrintable(fileName));
+        throw(std::runtime_error("Failed to open file for mapping.\n"));
+    }
+
+    size_ = file_->size();
+    if (size_ == 0)
+        return;
+
+    data_ = file_->map(0, file_->size());
+    if (!data_)
+    {
+        printf("Failed to map file '%s' (%s).\n", qPrintable(fileName), qPrintable(file_->errorString()));
+        throw(std::runtime_error("Failed to map file.\n"));
+    }
+}
+
+//! Return size of mapped data, in bytes
+std::size_t MappedFile::size() const { return size_; }
+
+//! Return mapped data
+const unsigned char *MappedFile::data() const { return data_; }
+
+//! Return column of values of the specified type, starting at the given byte offset
+/*!
+ * Return a column of values of the specified @param type, the first located @param offset bytes into the file and each
+ * subsequent value @param byteStride bytes after the last (by default, the size of a single value so that values are
+ * contiguous). If @param count is not given, the column extends as far as the file allows. No data is read from the file until
+ * values are accessed.
+ */
+DataColumn MappedFile::column(DataColumn::ElementType type, std::size_t offset, std::optional<std::size_t> byteStride,
+                              std::optional<std::size_t> count) const
+{
+    auto elementSize = DataColumn::elementSize(type);
+    auto stride = byteStride.value_or(elementSize);
+    if (stride < elementSize)
+    {
+        printf("Stride (%zu bytes) is smaller than the element size (%zu bytes).\n", stride, elementSize);
+        throw(std::runtime_error("Invalid stride for mapped column.\n"));
+    }
+
+    // Determine the number of complete values available
+    auto available = offset + elementSize <= size_ ? (size_ - offset - elementSize) / stride + 1 : 0;
+    if (count && *count > available)
+    {
+        printf("Requested %zu values from mapped file, but only %zu are available.\n", *count, available);
+        throw(std::runtime_error("Mapped column extends beyond end of file.\n"));
+    }
+
+    if (available == 0)
+        return {};
+
+    return {data_ + offset, count.value_or(available), stride, file_, type};
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "classes/datacolumn.h"
+#include <QFile>
+#include <optional>
+
+namespace Mildred
+{
+//! MappedFile provides data columns backed by a memory-mapped binary file
+/*!
+ * The @class MappedFile class maps a raw binary file into memory and provides @class DataColumn objects referencing the values
+ * within it, so that large datasets may be displayed without first being read into memory. Pages of the file are only read
+ * from disk when accessed, and may be discarded again by the operating system at any time, so the resident memory required
+ * is governed by the data actually accessed (e.g. that currently on screen) rather than the size of the file.
+ *
+ * Values must be stored in little-endian order as float32, float64, or int64. A file may contain a single column of values, or
+ * several interleaved columns (i.e. an array of records) accessed with a suitable offset and stride. Columns keep the mapping
+ * alive, so the MappedFile itself need not outlive them.
+ */
+class MappedFile
+{
+    public:
+    explicit MappedFile(const QString &fileName);
+    ~MappedFile() = default;
+
+    private:
+    // File, shared with (and kept open by) all columns referencing the mapping
+    std::shared_ptr<QFile> file_;
+    // Mapped data
+    const unsigned char *data_{nullptr};
+    // Size of mapped data, in bytes
+    std::size_t size_{0};
+
+    public:
+    // Return size of mapped data, in bytes
+    std::size_t size() const;
+    // Return mapped data
+    const unsigned char *data() const;
+    // Return column of values of the specified type, starting at the given byte offset
+    DataColumn column(DataColumn::ElementType type, std::size_t offset = 0,
+                      std::optional<std::size_t> byteStride = std::nullopt,
+                      std::optional<std::size_t> count = std::nullopt) const;
+};
+} // namespace Mildred
@@ -0,0 +1,300 @@
+#include "io/npyarray.h"
+#include <QRegularExpression>
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace Mildred;
+
+//! Open the specified NumPy array
+/*!
+ * Map @param fileName and read the header of the array it contains. For .npz archives the array is the specified @param
+ * member (with or without its .npy suffix), which may be omitted if the archive contains only a single array. Exceptions are
+ * thrown if the array cannot be mapped or is of an unsupported type or layout.
+ */
+NpyArray::NpyArray(const QString &fileName, const QString &member) : file_(fileName)
+{
+    if (!fileName.endsWith(".npz", Qt::CaseInsensitive))
+    {
+        if (!member.isEmpty())
+        {
+            printf("Member '%s' requested from '%s', which is not a .npz archive.\n", qPrintable(member), qPrintable(fileName));
+            throw(std::runtime_error("Member requested from non-archive NumPy file.\n"));
+        }
+        parseHeader(0);
+        return;
+    }
+
+    // Find the requested member in the archive
+    auto members = npzDirectory(file_);
+    auto it = std::find_if(members.begin(), members.end(), [&](const auto &m) {
+        return (member.isEmpty() && members.size() == 1) || m.name == member || m.name == member + ".npy";
+    });
+    if (it == members.end())
+    {
+        printf("Array '%s' not found in archive '%s'.\n", qPrintable(member), qPrintable(fileName));
+        throw(std::runtime_error("Array not found in NumPy archive.\n"));
+    }
+    if (it->method != 0)
+    {
+        printf("Array '%s' in archive '%s' is compressed and so can't be mapped (save with numpy.savez() rather than "
+               "numpy.savez_compressed()).\n",
+               qPrintable(it->name), qPrintable(fileName));
+        throw(std::runtime_error("Compressed NumPy archive member can't be mapped.\n"));
+    }
+
+    // Array data follows the member's local header, whose name and extra field lengths may differ from the directory's
+    auto *data = file_.data();
+    auto local = it->localHeaderOffset;
+    if (local + 30 > file_.size() || qFromLittleEndian<quint32>(data + local) != 0x04034b50)
+    {
+        printf("Invalid local header for array '%s' in archive '%s'.\n", qPrintable(it->name), qPrintable(fileName));
+        throw(std::runtime_error("Invalid NumPy archive.\n"));
+    }
+    parseHeader(local + 30 + qFromLittleEndian<quint16>(data + local + 26) + qFromLittleEndian<quint16>(data + local + 28));
+}
+
+/*
+ * Private Functions
+ */
+
+//! Return directory of the mapped .npz archive
+/*!
+ * Read the central directory of the zip archive in @param file, including the Zip64 extensions used by NumPy for large arrays.
+ */
+std::vector<NpyArray::NpzMember> NpyArray::npzDirectory(const MappedFile &file)
+{
+    auto *data = file.data();
+    auto size = file.size();
+
+    // Locate the end of central directory record, searching back over any archive comment
+    const std::size_t eocdSize = 22, maxCommentSize = 65535;
+    std::optional<std::size_t> eocd;
+    for (auto n = size < eocdSize ? 0 : size - eocdSize + 1; n-- > 0 && size - n <= eocdSize + maxCommentSize;)
+        if (qFromLittleEndian<quint32>(data + n) == 0x06054b50)
+        {
+            eocd = n;
+            break;
+        }
+    if (!eocd)
+    {
+        printf("No zip directory found in NumPy archive.\n");
+        throw(std::runtime_error("Invalid NumPy archive.\n"));
+    }
+
+    std::uint64_t nEntries = qFromLittleEndian<quint16>(data + *eocd + 10);
+    std::uint64_t directoryOffset = qFromLittleEndian<quint32>(data + *eocd + 16);
+
+    // Large archives have a Zip64 end of central directory record, referenced by a locator immediately preceding the record
+    if (*eocd >= 20 && qFromLittleEndian<quint32>(data + *eocd - 20) == 0x07064b50)
+    {
+        auto zip64Eocd = qFromLittleEndian<quint64>(data + *eocd - 12);
+        if (zip64Eocd + 56 > size || qFromLittleEndian<quint32>(data + zip64Eocd) != 0x06064b50)
+        {
+            printf("Invalid Zip64 directory in NumPy archive.\n");
+            throw(std::runtime_error("Invalid NumPy archive.\n"));
+        }
+        nEntries = qFromLittleEndian<quint64>(data + zip64Eocd + 32);
+        directoryOffset = qFromLittleEndian<quint64>(data + zip64Eocd + 48);
+    }
+
+    std::vector<NpzMember> members;
+    auto offset = directoryOffset;
+    for (std::uint64_t n = 0; n < nEntries; ++n)
+    {
+        if (offset + 46 > size || qFromLittleEndian<quint32>(data + offset) != 0x02014b50)
+        {
+            printf("Invalid directory entry %llu in NumPy archive.\n", (unsigned long long)n);
+            throw(std::runtime_error("Invalid NumPy archive.\n"));
+        }
+
+        auto method = qFromLittleEndian<quint16>(data + offset + 10);
+        auto compressedSize = qFromLittleEndian<quint32>(data + offset + 20);
+        auto uncompressedSize = qFromLittleEndian<quint32>(data + offset + 24);
+        auto nameLength = qFromLittleEndian<quint16>(data + offset + 28);
+        auto extraLength = qFromLittleEndian<quint16>(data + offset + 30);
+        auto commentLength = qFromLittleEndian<quint16>(data + offset + 32);
+        std::uint64_t localHeaderOffset = qFromLittleEndian<quint32>(data + offset + 42);
+        if (offset + 46 + nameLength + extraLength > size)
+        {
+            printf("Truncated directory entry %llu in NumPy archive.\n", (unsigned long long)n);
+            throw(std::runtime_error("Invalid NumPy archive.\n"));
+        }
+
+        // Saturated sizes and offsets are given in the Zip64 extra field instead, in a fixed order
+        if (localHeaderOffset == 0xffffffff)
+        {
+            auto extra = offset + 46 + nameLength, extraEnd = extra + extraLength;
+            while (extra + 4 <= extraEnd)
+            {
+                auto id = qFromLittleEndian<quint16>(data + extra), length = qFromLittleEndian<quint16>(data + extra + 2);
+                if (id == 0x0001)
+                {
+                    auto field = extra + 4;
+                    if (uncompressedSize == 0xffffffff)
+                        field += 8;
+                    if (compressedSize == 0xffffffff)
+                        field += 8;
+                    if (field + 8 <= extra + 4 + length)
+                        localHeaderOffset = qFromLittleEndian<quint64>(data + field);
+                    break;
+                }
+                extra += 4 + length;
+            }
+        }
+
+        members.push_back({QString::fromUtf8(reinterpret_cast<const char *>(data + offset + 46), nameLength), method,
+                           localHeaderOffset});
+
+        offset += 46 + nameLength + extraLength + commentLength;
+    }
+
+    return members;
+}
+
+//! Parse array header at the specified byte offset
+/*!
+ * Parse the .npy header starting @param offset bytes into the mapped file, setting the element type, shape, and data offset of
+ * the array.
+ */
+void NpyArray::parseHeader(std::size_t offset)
+{
+    auto *data = file_.data() + offset;
+    if (offset + 10 > file_.size() || std::memcmp(data, "\x93NUMPY", 6) != 0)
+    {
+        printf("Data is not a NumPy array.\n");
+        throw(std::runtime_error("Invalid NumPy array.\n"));
+    }
+
+    // Header length is 16-bit in version 1.0 of the format, and 32-bit thereafter
+    auto major = data[6];
+    std::size_t preambleLength = major == 1 ? 10 : 12;
+    if (major < 1 || major > 3 || offset + preambleLength > file_.size())
+    {
+        printf("Unsupported NumPy format version %i.\n", major);
+        throw(std::runtime_error("Invalid NumPy array.\n"));
+    }
+    std::size_t headerLength = major == 1 ? qFromLittleEndian<quint16>(data + 8) : qFromLittleEndian<quint32>(data + 8);
+    if (offset + preambleLength + headerLength > file_.size())
+    {
+        printf("Truncated NumPy array header.\n");
+        throw(std::runtime_error("Invalid NumPy array.\n"));
+    }
+    auto header = QString::fromUtf8(reinterpret_cast<const char *>(data + preambleLength), headerLength);
+
+    // Element type
+    auto descr = QRegularExpression(R"('descr'\s*:\s*'([^']*)')").match(header).captured(1);
+    if (descr == "<f8" || descr == "=f8")
+        elementType_ = DataColumn::ElementType::Float64;
+    else if (descr == "<f4" || descr == "=f4")
+        elementType_ = DataColumn::ElementType::Float32;
+    else if (descr == "<i8" || descr == "=i8")
+        elementType_ = DataColumn::ElementType::Int64;
+    else
+    {
+        printf("Unsupported NumPy element type '%s' (must be little-endian float32, float64, or int64).\n", qPrintable(descr));
+        throw(std::runtime_error("Unsupported NumPy element type.\n"));
+    }
+
+    // Order
+    if (!QRegularExpression(R"('fortran_order'\s*:\s*False)").match(header).hasMatch())
+    {
+        printf("NumPy array is not C-ordered.\n");
+        throw(std::runtime_error("Unsupported NumPy array order.\n"));
+    }
+
+    // Shape
+    auto shapeMatch = QRegularExpression(R"('shape'\s*:\s*\(([^)]*)\))").match(header);
+    shape_.clear();
+    auto validShape = shapeMatch.hasMatch();
+    for (auto &dimension : shapeMatch.captured(1).split(',', Qt::SkipEmptyParts))
+    {
+        auto ok = false;
+        shape_.push_back(dimension.trimmed().toULongLong(&ok));
+        if (!ok)
+        {
+            validShape = false;
+            break;
+        }
+    }
+    if (!validShape || shape_.empty() || shape_.size() > 2)
+    {
+        printf("Unsupported NumPy array shape '(%s)' (must be one- or two-dimensional).\n", qPrintable(shapeMatch.captured(1)));
+        throw(std::runtime_error("Unsupported NumPy array shape.\n"));
+    }
+    if (nColumns() == 0)
+    {
+        printf("NumPy array of shape '(%s)' contains no columns.\n", qPrintable(shapeMatch.captured(1)));
+        throw(std::runtime_error("Unsupported NumPy array shape.\n"));
+    }
+
+    dataOffset_ = offset + preambleLength + headerLength;
+
+    auto elementSize = DataColumn::elementSize(elementType_);
+    if (shape_[0] * nColumns() * elementSize > file_.size() - dataOffset_)
+    {
+        printf("NumPy array data is truncated.\n");
+        throw(std::runtime_error("Truncated NumPy array.\n"));
+    }
+}
+
+/*
+ * Public Functions
+ */
+
+//! Return names of the arrays stored in the specified .npz archive
+std::vector<QString> NpyArray::npzMembers(const QString &fileName)
+{
+    std::vector<QString> names;
+    for (auto &member : npzDirectory(MappedFile(fileName)))
+        names.push_back(member.name.endsWith(".npy") ? member.name.chopped(4) : member.name);
+    return names;
+}
+
+//! Return array shape
+const std::vector<std::size_t> &NpyArray::shape() const { return shape_; }
+
+//! Return element type
+DataColumn::ElementType NpyArray::elementType() const { return elementType_; }
+
+//! Return number of columns in the array
+/*!
+ * Return the number of columns in the array - one-dimensional arrays are treated as a single column.
+ */
+int NpyArray::nColumns() const { return shape_.size() == 1 ? 1 : int(shape_[1]); }
+
+//! Return specified column of the array
+/*!
+ * Return the column at @param index, referencing the array data within the mapped file. Columns of two-dimensional arrays are
+ * strided, with consecutive values separated by a whole row.
+ */
+DataColumn NpyArray::column(int index) const
+{
+    if (index < 0 || index >= nColumns())
+    {
+        printf("Column index %i out of range for NumPy array with %i columns.\n", index, nColumns());
+        throw(std::runtime_error("NumPy array column index out of range.\n"));
+    }
+
+    auto elementSize = DataColumn::elementSize(elementType_);
+    return file_.column(elementType_, dataOffset_ + index * elementSize, nColumns() * elementSize, shape_[0]);
+}
+
+//! Return x values and series for the array
+/*!
+ * Return the x values and series represented by the array. For arrays with more than one column the first column gives the x
+ * values shared by the series in the remaining columns. Arrays with a single column represent a single series, and x values
+ * are generated from the point indices.
+ */
+std::pair<DataColumn, std::vector<DataColumn>> NpyArray::series() const
+{
+    if (nColumns() == 1)
+        return {DataColumn::uniform(0.0, 1.0, shape_[0]), {column(0)}};
+
+    std::vector<DataColumn> values;
+    for (auto n = 1; n < nColumns(); ++n)
+        values.push_back(column(n));
+
+    return {column(0), values};
+}
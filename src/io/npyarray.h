@@ -0,0 +1,64 @@
+#pragma once
+
+#include "io/mappedfile.h"
+#include <vector>
+
+namespace Mildred
+{
+//! NpyArray provides data columns backed by a memory-mapped NumPy array
+/*!
+ * The @class NpyArray class reads the header of a NumPy array stored in a .npy file, or as an uncompressed (stored) member of a
+ * .npz archive, and provides @class DataColumn objects referencing the array data within the mapped file. Opening an array
+ * reads only its header, regardless of its size.
+ *
+ * Arrays must be one- or two-dimensional, C-ordered, and contain little-endian float32, float64, or int64 values. For
+ * two-dimensional arrays each row is taken to be a record (point) and each column a quantity, with the first column giving
+ * the x values shared by the series in the remaining columns (i.e. as produced by numpy.column_stack((x, y1, y2, ...))).
+ */
+class NpyArray
+{
+    public:
+    explicit NpyArray(const QString &fileName, const QString &member = {});
+    ~NpyArray() = default;
+
+    private:
+    // Mapped file containing the array
+    MappedFile file_;
+    // Array shape
+    std::vector<std::size_t> shape_;
+    // Element type
+    DataColumn::ElementType elementType_{DataColumn::ElementType::Float64};
+    // Byte offset of array data within the mapped file
+    std::size_t dataOffset_{0};
+
+    private:
+    // Member of a .npz archive
+    struct NpzMember
+    {
+        // Member name
+        QString name;
+        // Compression method (zero for stored members)
+        int method;
+        // Byte offset of local header
+        std::size_t localHeaderOffset;
+    };
+    // Return directory of the mapped .npz archive
+    static std::vector<NpzMember> npzDirectory(const MappedFile &file);
+    // Parse array header at the specified byte offset
+    void parseHeader(std::size_t offset);
+
+    public:
+    // Return names of the arrays stored in the specified .npz archive
+    static std::vector<QString> npzMembers(const QString &fileName);
+    // Return array shape
+    const std::vector<std::size_t> &shape() const;
+    // Return element type
+    DataColumn::ElementType elementType() const;
+    // Return number of columns in the array
+    int nColumns() const;
+    // Return specified column of the array
+    DataColumn column(int index) const;
+    // Return x values and series for the array
+    std::pair<DataColumn, std::vector<DataColumn>> series() const;
+};
+} // namespace Mildred
@@ -0,0 +1,298 @@
+#include "io/textloader.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#if !defined(__cpp_lib_to_chars) && __has_include(<xlocale.h>)
+#include <xlocale.h>
+#endif
+
+using namespace Mildred;
+
+TextLoader::TextLoader(const QString &fileName, QObject *parent) : QObject(parent), fileName_(fileName) {}
+
+TextLoader::~TextLoader() { stop(); }
+
+/*
+ * Definition
+ */
+
+//! Set indices of columns containing axis values, data values, and (optionally) errors
+/*!
+ * Set the (zero-based) indices of the fields containing axis values (@param xColumn), data values (@param valueColumn), and
+ * optionally errors (@param errorColumn). The default is to read axis values and data values from the first two fields. An
+ * exception is thrown if any index is negative.
+ */
+void TextLoader::setColumns(int xColumn, int valueColumn, std::optional<int> errorColumn)
+{
+    if (xColumn < 0 || valueColumn < 0 || errorColumn.value_or(0) < 0)
+    {
+        printf("Invalid column indices (%i (x), %i (values), %i (errors)) - indices must not be negative.\n", xColumn,
+               valueColumn, errorColumn.value_or(0));
+        throw(std::runtime_error("Invalid column indices for text loader.\n"));
+    }
+
+    xColumn_ = xColumn;
+    valueColumn_ = valueColumn;
+    errorColumn_ = errorColumn;
+}
+
+//! Set number of worker threads
+/*!
+ * Set the number of threads parsing the file in parallel, or zero (the default) to use all available hardware threads.
+ */
+void TextLoader::setThreadCount(int nThreads) { nThreads_ = std::max(0, nThreads); }
+
+//! Set target size of chunks, in bytes
+/*!
+ * Set the target size of the chunks into which the file is split. Each chunk is extended to the end of the line in which it
+ * would otherwise finish. Smaller chunks deliver the first data sooner, at the cost of more frequent updates.
+ */
+void TextLoader::setChunkSize(std::size_t bytes) { chunkSize_ = std::max(std::size_t(1), bytes); }
+
+/*
+ * Loading
+ */
+
+//! Parse floating-point value from the start of the specified range
+/*!
+ * Parse a value from the start of the range [@param first, @param last) into @param value, returning the end of the value and
+ * any error as std::from_chars() would. Where the standard library provides floating-point std::from_chars() it is used
+ * directly, converting without locale lookups or allocations. Otherwise (e.g. libc++ prior to LLVM 20) the value is copied to a
+ * null-terminated buffer and converted with strtod_l() in the C locale.
+ */
+std::from_chars_result TextLoader::parseValue(const char *first, const char *last, double &value)
+{
+#if defined(__cpp_lib_to_chars)
+    return std::from_chars(first, last, value);
+#else
+    static const auto cLocale = newlocale(LC_ALL_MASK, "C", nullptr);
+
+    // No numeric field is this long, so a truncated copy will fail to parse as a whole field
+    char buffer[128];
+    auto length = std::min(std::size_t(last - first), sizeof(buffer) - 1);
+    std::memcpy(buffer, first, length);
+    buffer[length] = '\0';
+
+    char *end = nullptr;
+    errno = 0;
+    value = strtod_l(buffer, &end, cLocale);
+    if (end == buffer || std::isspace(static_cast<unsigned char>(buffer[0])))
+        return {first, std::errc::invalid_argument};
+    return {first + (end - buffer), errno == ERANGE ? std::errc::result_out_of_range : std::errc()};
+#endif
+}
+
+//! Parse specified chunk
+/*!
+ * Parse all lines within @param chunk, converting fields with parseValue().
+ */
+void TextLoader::parseChunk(Chunk &chunk) const
+{
+    auto *text = reinterpret_cast<const char *>(file_->data());
+    auto maxColumn = std::max({xColumn_, valueColumn_, errorColumn_.value_or(0)});
+    std::vector<double> fields(maxColumn + 1);
+    auto isDelimiter = [](char c) { return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r'; };
+
+    const char *line = text + chunk.begin, *end = text + chunk.end;
+    while (line < end)
+    {
+        auto *lineEnd = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        if (!lineEnd)
+            lineEnd = end;
+
+        // Parse fields up to the last required, stopping at the end of the line or a comment
+        auto nFields = 0;
+        auto valid = true;
+        auto *c = line;
+        while (nFields <= maxColumn)
+        {
+            while (c < lineEnd && isDelimiter(*c))
+                ++c;
+            if (c == lineEnd || *c == '#')
+                break;
+            if (*c == '+')
+                ++c;
+            auto [next, error] = parseValue(c, lineEnd, fields[nFields]);
+            if (error != std::errc() || (next != lineEnd && !isDelimiter(*next) && *next != '#'))
+            {
+                valid = false;
+                break;
+            }
+            ++nFields;
+            c = next;
+        }
+
+        if (valid && nFields > maxColumn)
+        {
+            chunk.x.push_back(fields[xColumn_]);
+            chunk.values.push_back(fields[valueColumn_]);
+            if (errorColumn_)
+                chunk.errors.push_back(fields[*errorColumn_]);
+        }
+        else if (!valid || nFields > 0)
+            ++chunk.nSkippedLines;
+
+        line = lineEnd + 1;
+    }
+}
+
+//! Parse chunks until none remain
+/*!
+ * Chunks are taken in file order, so that the start of the file is available as soon as possible. Delivery of each parsed chunk
+ * is queued on the thread owning the loader.
+ */
+void TextLoader::work()
+{
+    for (auto index = nextChunk_++; index < chunks_.size() && !cancelled_; index = nextChunk_++)
+    {
+        parseChunk(chunks_[index]);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            chunks_[index].parsed = true;
+        }
+
+        QMetaObject::invokeMethod(this, [this]() { deliverChunks(); }, Qt::QueuedConnection);
+    }
+}
+
+//! Deliver consecutive parsed chunks in file order
+/*!
+ * All consecutive parsed chunks following the last delivered are combined and emitted as a single set of columns, so that
+ * receivers are not updated more often than they can keep up with.
+ */
+void TextLoader::deliverChunks()
+{
+    std::vector<double> x, values, errors;
+    auto nDelivered = 0;
+    for (; nextDelivery_ < chunks_.size(); ++nextDelivery_, ++nDelivered)
+    {
+        auto &chunk = chunks_[nextDelivery_];
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!chunk.parsed)
+                break;
+        }
+
+        x.insert(x.end(), chunk.x.begin(), chunk.x.end());
+        values.insert(values.end(), chunk.values.begin(), chunk.values.end());
+        errors.insert(errors.end(), chunk.errors.begin(), chunk.errors.end());
+        nBytesDelivered_ += chunk.end - chunk.begin;
+        nSkippedLines_ += chunk.nSkippedLines;
+        chunk.x = {};
+        chunk.values = {};
+        chunk.errors = {};
+    }
+
+    if (nDelivered == 0)
+        return;
+
+    if (!x.empty())
+    {
+        std::optional<DataColumn> errorColumn;
+        if (errorColumn_)
+            errorColumn = DataColumn(std::move(errors));
+        emit(chunkLoaded(DataColumn(std::move(x)), DataColumn(std::move(values)), errorColumn));
+    }
+
+    if (nextDelivery_ == chunks_.size())
+    {
+        elapsed_ = timer_.nsecsElapsed();
+        emit(finished());
+    }
+}
+
+//! Cancel loading and wait for worker threads to finish
+void TextLoader::stop()
+{
+    cancelled_ = true;
+    for (auto &thread : threads_)
+        thread.join();
+    threads_.clear();
+}
+
+//! Start loading in the background
+/*!
+ * Map the file, split it into chunks, and start parsing them on worker threads. Data are delivered through chunkLoaded() from
+ * the event loop of the thread owning the loader, and finished() is emitted once all data have been delivered. An exception is
+ * thrown if the file cannot be mapped.
+ */
+void TextLoader::start()
+{
+    stop();
+
+    file_.emplace(fileName_);
+    chunks_.clear();
+    nextChunk_ = 0;
+    nextDelivery_ = 0;
+    cancelled_ = false;
+    nBytesDelivered_ = 0;
+    elapsed_ = 0;
+    nSkippedLines_ = 0;
+    timer_.start();
+
+    // Split into chunks, each extended to the end of its last line
+    auto *text = reinterpret_cast<const char *>(file_->data());
+    auto size = file_->size();
+    for (std::size_t begin = 0; begin < size;)
+    {
+        auto end = std::min(size, begin + chunkSize_);
+        if (end < size)
+        {
+            auto *newline = static_cast<const char *>(std::memchr(text + end, '\n', size - end));
+            end = newline ? newline - text + 1 : size;
+        }
+        chunks_.push_back({begin, end});
+        begin = end;
+    }
+
+    if (chunks_.empty())
+    {
+        emit(finished());
+        return;
+    }
+
+    auto nThreads = nThreads_ > 0 ? nThreads_ : int(std::max(1u, std::thread::hardware_concurrency()));
+    nThreads = std::min(nThreads, int(chunks_.size()));
+    for (auto n = 0; n < nThreads; ++n)
+        threads_.emplace_back(&TextLoader::work, this);
+}
+
+//! Wait for loading to complete, delivering all remaining data
+/*!
+ * Block until all chunks have been parsed and then deliver any which remain, allowing the loader to be used synchronously.
+ */
+void TextLoader::wait()
+{
+    for (auto &thread : threads_)
+        thread.join();
+    threads_.clear();
+
+    deliverChunks();
+}
+
+//! Return whether all data have been delivered
+bool TextLoader::isFinished() const { return file_ && nextDelivery_ == chunks_.size(); }
+
+//! Return number of bytes delivered
+std::size_t TextLoader::nBytesDelivered() const { return nBytesDelivered_; }
+
+//! Return number of lines skipped because they could not be parsed
+int TextLoader::nSkippedLines() const { return nSkippedLines_; }
+
+//! Return parse throughput, in MB/s
+/*!
+ * Return the throughput achieved so far, from the number of bytes delivered and the time since loading started. Once loading
+ * has finished this is the overall throughput for the whole file.
+ */
+double TextLoader::throughput() const
+{
+    if (!file_)
+        return 0.0;
+
+    auto nanoseconds = isFinished() ? elapsed_ : timer_.nsecsElapsed();
+    return nanoseconds > 0 ? nBytesDelivered_ * 1.0e3 / nanoseconds : 0.0;
+}
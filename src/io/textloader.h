@@ -0,0 +1,124 @@
+#pragma once
+
+#include "io/mappedfile.h"
+#include <QElapsedTimer>
+#include <QObject>
+#include <atomic>
+#include <charconv>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Mildred
+{
+//! TextLoader loads columns of numbers from a delimited text file in parallel
+/*!
+ * The @class TextLoader class reads columns of numbers from a memory-mapped text file, with fields separated by any mix of
+ * whitespace, commas, and semicolons. The file is split into chunks on line boundaries which are parsed in parallel by a pool
+ * of worker threads, and parsed data are delivered in file order through the chunkLoaded() signal (emitted on the thread
+ * owning the loader) as soon as they are available. Connecting chunkLoaded() to Data1DEntity::appendData() therefore displays
+ * the start of the file while the remainder is still being parsed.
+ *
+ * Blank lines and comments (introduced by '#') are ignored, as are any fields beyond those requested. Lines whose requested
+ * fields cannot be parsed (e.g. column headings) are skipped and counted.
+ */
+class TextLoader : public QObject
+{
+    Q_OBJECT
+
+    public:
+    TextLoader(const QString &fileName, QObject *parent = nullptr);
+    ~TextLoader();
+
+    /*
+     * Definition
+     */
+    private:
+    // Name of file to load
+    QString fileName_;
+    // Indices of columns containing axis values, data values, and (optionally) errors
+    int xColumn_{0}, valueColumn_{1};
+    std::optional<int> errorColumn_;
+    // Number of worker threads (zero to use all available hardware threads)
+    int nThreads_{0};
+    // Target size of chunks, in bytes
+    std::size_t chunkSize_{4 * 1024 * 1024};
+
+    public:
+    // Set indices of columns containing axis values, data values, and (optionally) errors
+    void setColumns(int xColumn, int valueColumn, std::optional<int> errorColumn = std::nullopt);
+    // Set number of worker threads
+    void setThreadCount(int nThreads);
+    // Set target size of chunks, in bytes
+    void setChunkSize(std::size_t bytes);
+
+    /*
+     * Loading
+     */
+    private:
+    // Chunk of the file
+    struct Chunk
+    {
+        // Byte range within the file
+        std::size_t begin, end;
+        // Parsed values
+        std::vector<double> x, values, errors;
+        // Number of lines which could not be parsed
+        int nSkippedLines{0};
+        // Whether the chunk has been parsed
+        bool parsed{false};
+    };
+    // Mapped file
+    std::optional<MappedFile> file_;
+    // Chunks of the file, in file order
+    std::vector<Chunk> chunks_;
+    // Index of the next chunk to be parsed
+    std::atomic<std::size_t> nextChunk_{0};
+    // Index of the next chunk to be delivered
+    std::size_t nextDelivery_{0};
+    // Mutex protecting parsed flags of chunks
+    std::mutex mutex_;
+    // Worker threads
+    std::vector<std::thread> threads_;
+    // Whether loading has been cancelled
+    std::atomic<bool> cancelled_{false};
+    // Timer started at the beginning of loading
+    QElapsedTimer timer_;
+    // Number of bytes delivered
+    std::size_t nBytesDelivered_{0};
+    // Time taken to deliver all chunks, in nanoseconds
+    qint64 elapsed_{0};
+    // Number of lines delivered which could not be parsed
+    int nSkippedLines_{0};
+
+    private:
+    // Parse floating-point value from the start of the specified range
+    static std::from_chars_result parseValue(const char *first, const char *last, double &value);
+    // Parse specified chunk
+    void parseChunk(Chunk &chunk) const;
+    // Parse chunks until none remain
+    void work();
+    // Deliver consecutive parsed chunks in file order
+    void deliverChunks();
+    // Cancel loading and wait for worker threads to finish
+    void stop();
+
+    public:
+    // Start loading in the background
+    void start();
+    // Wait for loading to complete, delivering all remaining data
+    void wait();
+    // Return whether all data have been delivered
+    bool isFinished() const;
+    // Return number of bytes delivered
+    std::size_t nBytesDelivered() const;
+    // Return number of lines skipped because they could not be parsed
+    int nSkippedLines() const;
+    // Return parse throughput, in MB/s
+    double throughput() const;
+
+    signals:
+    void chunkLoaded(DataColumn x, DataColumn values, std::optional<DataColumn> errors);
+    void finished();
+};
+} // namespace Mildred
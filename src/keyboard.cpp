@@ -21,7 +21,7 @@ void MildredWidget::keyReleaseEvent(QKeyEvent *event)
                 yAxis_->shiftLimits(yAxis_->range() * (event->key() == Qt::Key_Up ? -0.02 : 0.02));
             else
                 yAxis_->shiftLimits(yAxis_->range() * (event->key() == Qt::Key_Up ? -0.1 : 0.1));
-            updateTransforms();
+            invalidate(Invalidation::Axes);
             break;
         case (Qt::Key_Left):
         case (Qt::Key_Right):
@@ -31,7 +31,7 @@ void MildredWidget::keyReleaseEvent(QKeyEvent *event)
                 xAxis_->shiftLimits(xAxis_->range() * (event->key() == Qt::Key_Right ? -0.02 : 0.02));
             else
                 xAxis_->shiftLimits(xAxis_->range() * (event->key() == Qt::Key_Right ? -0.1 : 0.1));
-            updateTransforms();
+            invalidate(Invalidation::Axes);
             break;
         default:
             break;
@@ -2,17 +2,24 @@
 #include <QVector3D>
 #include <Qt3DRender/QFilterKey>
 #include <Qt3DRender/QGraphicsApiFilter>
+#include <Qt3DRender/QPointSize>
 #include <Qt3DRender/QRenderPass>
 #include <Qt3DRender/QShaderProgram>
 #include <Qt3DRender/QTechnique>
 #include <QtCore/QUrl>
+#include <map>
 #include <stdexcept>
 
 using namespace Mildred;
 
-RenderableMaterial::RenderableMaterial(Qt3DCore::QNode *parent, VertexShaderType vertexShader,
-                                       GeometryShaderType geometryShader, FragmentShaderType fragmentShader)
-    : Qt3DRender::QMaterial(parent)
+//! Create a new RenderableMaterial
+/*!
+ * Construct a new RenderableMaterial using the supplied (and potentially shared) @param effect, which implements the specified
+ * @param shaders. Colour components are stored as parameters local to the material, so many materials may share a single
+ * effect (and its shader program) while retaining their own colours.
+ */
+RenderableMaterial::RenderableMaterial(Qt3DCore::QNode *parent, Qt3DRender::QEffect *effect, ShaderCombination shaders)
+    : Qt3DRender::QMaterial(parent), shaders_(shaders)
 {
     // Initialise parameters
     ambient_.setNamedColor("#000000");
@@ -34,22 +41,79 @@ RenderableMaterial::RenderableMaterial(Qt3DCore::QNode *parent, VertexShaderType
     addParameter(specularReflectionParameter_);
     addParameter(shininessParameter_);
 
-    auto *filterKey = new Qt3DRender::QFilterKey;
+    setEffect(effect);
+}
+
+/*
+ * Effect
+ */
+
+//! Return source code for the specified shader resource, with optional preprocessor definition
+/*!
+ * Return the source code contained in the specified shader @param resource. If a @param define is given, it is inserted as a
+ * preprocessor definition immediately after the #version directive, allowing variants of a single shader to be generated.
+ * Sources are loaded from the Qt resource system only once, and subsequently returned from a local cache.
+ */
+QByteArray RenderableMaterial::shaderSource(const QString &resource, const QByteArray &define)
+{
+    static std::map<std::pair<QString, QByteArray>, QByteArray> sources;
+
+    auto key = std::make_pair(resource, define);
+    auto it = sources.find(key);
+    if (it == sources.end())
+    {
+        auto source = Qt3DRender::QShaderProgram::loadSource(QUrl(resource));
+        if (!define.isEmpty())
+            source.insert(source.indexOf('\n') + 1, "#define " + define + "\n");
+        it = sources.emplace(key, source).first;
+    }
+
+    return it->second;
+}
+
+//! Create new effect implementing the specified shader combination
+/*!
+ * Create a new QEffect, owned by @param parent, implementing the specified @param vertexShader, @param geometryShader, and
+ * @param fragmentShader. The effect contains a single GL 3.1 technique and render pass.
+ */
+Qt3DRender::QEffect *RenderableMaterial::createEffect(Qt3DCore::QNode *parent, VertexShaderType vertexShader,
+                                                      GeometryShaderType geometryShader, FragmentShaderType fragmentShader)
+{
+    auto *effect = new Qt3DRender::QEffect(parent);
+
+    auto *filterKey = new Qt3DRender::QFilterKey(effect);
     filterKey->setName(QStringLiteral("renderingStyle"));
     filterKey->setValue(QStringLiteral("forward"));
 
     // Set up GL 3.1 shader, render pass and technique
-    auto *shader3 = new Qt3DRender::QShaderProgram(this);
+    auto *shader3 = new Qt3DRender::QShaderProgram(effect);
 
     switch (vertexShader)
     {
         case (VertexShaderType::Unclipped):
-            shader3->setVertexShaderCode(
-                Qt3DRender::QShaderProgram::loadSource(QUrl(QStringLiteral("qrc:/shaders/shaders/unclipped.vert"))));
+            shader3->setVertexShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/unclipped.vert")));
             break;
         case (VertexShaderType::ClippedToDataVolume):
+            shader3->setVertexShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/clipped.vert")));
+            break;
+        case (VertexShaderType::Flat):
+            shader3->setVertexShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/flat.vert")));
+            break;
+        case (VertexShaderType::Point):
+            shader3->setVertexShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/point.vert")));
+            break;
+        case (VertexShaderType::InstancedLine):
+            shader3->setVertexShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/line_instanced.vert")));
+            break;
+        case (VertexShaderType::ClippedInstancedLine):
             shader3->setVertexShaderCode(
-                Qt3DRender::QShaderProgram::loadSource(QUrl(QStringLiteral("qrc:/shaders/shaders/clipped.vert"))));
+                shaderSource(QStringLiteral("qrc:/shaders/shaders/line_instanced.vert"), "CLIP_TO_DATA_VOLUME"));
+            break;
+        case (VertexShaderType::ScreenQuad):
+            shader3->setVertexShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/screenquad.vert")));
+            break;
+        case (VertexShaderType::Glyph):
+            shader3->setVertexShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/glyph.vert")));
             break;
         default:
             throw(std::runtime_error("Unhandled vertex shader type.\n"));
@@ -59,8 +123,7 @@ RenderableMaterial::RenderableMaterial(Qt3DCore::QNode *parent, VertexShaderType
         case (GeometryShaderType::None):
             break;
         case (GeometryShaderType::LineTesselator):
-            shader3->setGeometryShaderCode(
-                Qt3DRender::QShaderProgram::loadSource(QUrl(QStringLiteral("qrc:/shaders/shaders/line_tesselator.geom"))));
+            shader3->setGeometryShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/line_tesselator.geom")));
             break;
         default:
             throw(std::runtime_error("Unhandled geometry shader type.\n"));
@@ -68,25 +131,38 @@ RenderableMaterial::RenderableMaterial(Qt3DCore::QNode *parent, VertexShaderType
     switch (fragmentShader)
     {
         case (FragmentShaderType::Monochrome):
-            shader3->setFragmentShaderCode(
-                Qt3DRender::QShaderProgram::loadSource(QUrl(QStringLiteral("qrc:/shaders/shaders/monochrome.frag"))));
+            shader3->setFragmentShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/monochrome.frag")));
             break;
         case (FragmentShaderType::Phong):
-            shader3->setFragmentShaderCode(
-                Qt3DRender::QShaderProgram::loadSource(QUrl(QStringLiteral("qrc:/shaders/shaders/phong.frag"))));
+            shader3->setFragmentShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/phong.frag")));
             break;
         case (FragmentShaderType::PerVertexPhong):
-            shader3->setFragmentShaderCode(
-                Qt3DRender::QShaderProgram::loadSource(QUrl(QStringLiteral("qrc:/shaders/shaders/phongpervertex.frag"))));
+            shader3->setFragmentShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/phongpervertex.frag")));
+            break;
+        case (FragmentShaderType::PerVertexColour):
+            shader3->setFragmentShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/pervertexcolour.frag")));
+            break;
+        case (FragmentShaderType::Texture):
+            shader3->setFragmentShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/texture.frag")));
+            break;
+        case (FragmentShaderType::Glyph):
+            shader3->setFragmentShaderCode(shaderSource(QStringLiteral("qrc:/shaders/shaders/glyph.frag")));
             break;
         default:
             throw(std::runtime_error("Unhandled fragment shader type.\n"));
     }
 
-    auto *renderPass3 = new Qt3DRender::QRenderPass(this);
+    auto *renderPass3 = new Qt3DRender::QRenderPass(effect);
     renderPass3->setShaderProgram(shader3);
+    if (vertexShader == VertexShaderType::Point)
+    {
+        // Point size is set by the vertex shader
+        auto *pointSize = new Qt3DRender::QPointSize(renderPass3);
+        pointSize->setSizeMode(Qt3DRender::QPointSize::Programmable);
+        renderPass3->addRenderState(pointSize);
+    }
 
-    auto *techniqueGL31 = new Qt3DRender::QTechnique();
+    auto *techniqueGL31 = new Qt3DRender::QTechnique(effect);
     techniqueGL31->addRenderPass(renderPass3);
     techniqueGL31->addFilterKey(filterKey);
     techniqueGL31->graphicsApiFilter()->setApi(Qt3DRender::QGraphicsApiFilter::OpenGL);
@@ -94,11 +170,33 @@ RenderableMaterial::RenderableMaterial(Qt3DCore::QNode *parent, VertexShaderType
     techniqueGL31->graphicsApiFilter()->setMinorVersion(1);
     techniqueGL31->graphicsApiFilter()->setProfile(Qt3DRender::QGraphicsApiFilter::CoreProfile);
 
-    auto *effect = new Qt3DRender::QEffect(this);
     effect->addTechnique(techniqueGL31);
+
+    return effect;
+}
+
+//! Set effect and the shader combination it implements
+/*!
+ * Replace the current effect with @param effect, which implements the specified @param shaders. Any line geometry using this
+ * material must be recreated if drawsInstancedLines() changes as a result.
+ */
+void RenderableMaterial::setShaders(Qt3DRender::QEffect *effect, ShaderCombination shaders)
+{
+    shaders_ = shaders;
     setEffect(effect);
 }
 
+//! Return shader combination implemented by the current effect
+RenderableMaterial::ShaderCombination RenderableMaterial::shaders() const { return shaders_; }
+
+//! Return whether lines drawn with this material must be supplied as instanced segments
+bool RenderableMaterial::drawsInstancedLines() const
+{
+    auto vertexShader = std::get<VertexShaderType>(shaders_);
+    return vertexShader == VertexShaderType::InstancedLine || vertexShader == VertexShaderType::ClippedInstancedLine ||
+           vertexShader == VertexShaderType::Flat;
+}
+
 /*
  * General Properties
  */
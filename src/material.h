@@ -1,7 +1,9 @@
 #pragma once
 
+#include <Qt3DRender/QEffect>
 #include <Qt3DRender/QMaterial>
 #include <Qt3DRender/QParameter>
+#include <tuple>
 
 namespace Mildred
 {
@@ -13,7 +15,13 @@ class RenderableMaterial : public Qt3DRender::QMaterial
     enum class VertexShaderType
     {
         Unclipped,
-        ClippedToDataVolume
+        ClippedToDataVolume,
+        Flat,
+        Point,
+        InstancedLine,
+        ClippedInstancedLine,
+        ScreenQuad,
+        Glyph
     };
     // Geometry Shader Types
     enum class GeometryShaderType
@@ -26,10 +34,36 @@ class RenderableMaterial : public Qt3DRender::QMaterial
     {
         Monochrome,
         Phong,
-        PerVertexPhong
+        PerVertexPhong,
+        PerVertexColour,
+        Texture,
+        Glyph
     };
-    explicit RenderableMaterial(Qt3DCore::QNode *parent, VertexShaderType vertexShader, GeometryShaderType geometryShader,
-                                FragmentShaderType fragmentShader);
+    // Shader combination, uniquely identifying an effect
+    using ShaderCombination = std::tuple<VertexShaderType, GeometryShaderType, FragmentShaderType>;
+    explicit RenderableMaterial(Qt3DCore::QNode *parent, Qt3DRender::QEffect *effect, ShaderCombination shaders);
+
+    /*
+     * Effect
+     */
+    private:
+    // Shader combination implemented by the current effect
+    ShaderCombination shaders_;
+
+    private:
+    // Return source code for the specified shader resource, with optional preprocessor definition
+    static QByteArray shaderSource(const QString &resource, const QByteArray &define = {});
+
+    public:
+    // Create new effect implementing the specified shader combination
+    static Qt3DRender::QEffect *createEffect(Qt3DCore::QNode *parent, VertexShaderType vertexShader,
+                                             GeometryShaderType geometryShader, FragmentShaderType fragmentShader);
+    // Set effect and the shader combination it implements
+    void setShaders(Qt3DRender::QEffect *effect, ShaderCombination shaders);
+    // Return shader combination implemented by the current effect
+    ShaderCombination shaders() const;
+    // Return whether lines drawn with this material must be supplied as instanced segments
+    bool drawsInstancedLines() const;
 
     /*
      * General Properties
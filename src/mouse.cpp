@@ -1,4 +1,5 @@
 #include "widget.h"
+#include <utility>
 
 using namespace Mildred;
 
@@ -12,8 +13,8 @@ using namespace Mildred;
  *
  * | Button | View Type | Modifier | Action |
  * | :----: | :-------: | :------: | ------ |
- * | Left   | Flat / 2D | None     | Update current coordinate under the mouse. |
- * | ^      | ^         | Ctrl     |        |
+ * | Left   | Flat / 2D | None     | Drag out a rectangular selection region. |
+ * | ^      | ^         | Ctrl     | Drag out a freehand (lasso) selection region. |
  * | ^      | ^         | Shift    |        |
  * | ^      | 3D        | None     | None   |
  * | ^      | ^         | Ctrl     |        |
@@ -30,6 +31,8 @@ using namespace Mildred;
  * | ^      | 3D        | None     | Rotate view volume around its centroid. |
  * | ^      | ^         | Ctrl     |        |
  * | ^      | ^         | Shift    |        |
+ *
+ * The effects of events are accumulated and applied once, at the start of the next frame (see applyPendingInput()).
  */
 void MildredWidget::mousePositionChanged(Qt3DInput::QMouseEvent *event)
 {
@@ -37,111 +40,256 @@ void MildredWidget::mousePositionChanged(Qt3DInput::QMouseEvent *event)
     setFocus();
 
     // Check previous position
+    auto position = QPoint(event->x(), event->y());
     if (lastMousePosition_.isNull())
     {
-        lastMousePosition_ = QPoint(event->x(), event->y());
+        lastMousePosition_ = position;
         return;
     }
 
     // Right button - Rotate scene volume (3D)
-    if (event->buttons() & Qt3DInput::QMouseEvent::RightButton)
+    if ((event->buttons() & Qt3DInput::QMouseEvent::RightButton) && !flatView_)
+        pendingInput_.rotation += position - lastMousePosition_;
+
+    // Middle button - translate axis ranges (2D)
+    if ((event->buttons() & Qt3DInput::QMouseEvent::MiddleButton) && flatView_)
+        pendingInput_.translation += position - lastMousePosition_;
+
+    // Left button - extend selection region (2D)
+    if ((event->buttons() & Qt3DInput::QMouseEvent::LeftButton) && !selectionRegion_.isEmpty())
     {
-        // Rotations only allowed for 3D view
-        if (!flatView_)
-        {
-            viewRotationMatrix_ *=
-                QQuaternion::fromEulerAngles(event->y() - lastMousePosition_.y(), event->x() - lastMousePosition_.x(), 0.0);
-            sceneRootTransform_->setRotation(viewRotationMatrix_);
-        }
+        if (lassoSelection_)
+            selectionRegion_ << position;
+        else
+            selectionRegion_ = QPolygon({selectionRegion_.front(), position});
+        pendingInput_.selectionRegionChanged = true;
     }
 
-    // Middle button - translate axis ranges (2D)
-    if (event->buttons() & Qt3DInput::QMouseEvent::MiddleButton)
+    lastMousePosition_ = position;
+    pendingInput_.cursorPosition = position;
+
+    ++renderStatistics_.inputEventsReceived;
+    invalidate(Invalidation::Input);
+}
+
+//! React to mouse button press
+/*!
+ * In flat views, pressing the left button begins dragging out a selection region - a rectangle, or a freehand lasso if Ctrl is
+ * held.
+ */
+void MildredWidget::mouseButtonPressed(Qt3DInput::QMouseEvent *event)
+{
+    if (!flatView_ || event->button() != Qt3DInput::QMouseEvent::LeftButton)
+        return;
+
+    lassoSelection_ = event->modifiers() & Qt3DInput::QMouseEvent::ControlModifier;
+    selectionRegion_ = QPolygon({QPoint(event->x(), event->y())});
+}
+
+//! React to mouse button release
+/*!
+ * Releasing the left button selects all data points within the region dragged out since it was pressed. A click without any
+ * significant movement clears the selection.
+ */
+void MildredWidget::mouseButtonReleased(Qt3DInput::QMouseEvent *event)
+{
+    if (selectionRegion_.isEmpty() || event->button() != Qt3DInput::QMouseEvent::LeftButton)
+        return;
+
+    auto region = selectionRegion_;
+    region << QPoint(event->x(), event->y());
+    selectionRegion_.clear();
+    pendingInput_.selectionRegionChanged = false;
+    updateSelectionRegionEntity();
+
+    if (region.boundingRect().width() < 3 && region.boundingRect().height() < 3)
+        clearSelection();
+    else if (lassoSelection_)
+        selectPolygon(region);
+    else
+        selectRectangle(QRect(region.front(), region.back()).normalized());
+}
+
+//! React to mouse wheel
+/*!
+ * In flat views, the wheel zooms the axes in or out around the mouse position.
+ */
+void MildredWidget::mouseWheeled(Qt3DInput::QWheelEvent *event)
+{
+    if (!flatView_)
+        return;
+
+    pendingInput_.zoomSteps += event->angleDelta().y() > 0 ? 1 : -1;
+    pendingInput_.zoomPosition = QPoint(event->x(), event->y());
+
+    ++renderStatistics_.inputEventsReceived;
+    invalidate(Invalidation::Input);
+}
+
+//! Update the mouse coordinate display for the specified widget position
+void MildredWidget::updateMouseCoordinates(QPoint pos)
+{
+    if (!flatView_)
+        return;
+
+    // Ensure that mouse is within plot area.
+    if ((pos.x() >= metrics_.displayVolumeOrigin().x()) &&
+        (pos.x() <= (metrics_.displayVolumeExtent().x() + metrics_.displayVolumeOrigin().x())) &&
+        (height() - pos.y() >= metrics_.displayVolumeOrigin().y()) &&
+        (height() - pos.y() <= (metrics_.displayVolumeExtent().y() + metrics_.displayVolumeOrigin().y())))
     {
-        if (flatView_)
+        // Convert mouse position to 2D axes value.
+        auto coords = toAxes2D(QPoint(pos.x(), height() - pos.y()));
+
+        // Emit signal indicating that mouse coordinates have been changed.
+        emit mouseCoordChanged(coords);
+
+        // Update the mouse coordinates in the text entity - this only rewrites a small vertex buffer.
+        mouseCoordEntity_->setText(QString("%1 %2").arg(coords.x(), 0, 'g', 4).arg(coords.y(), 0, 'g', 4));
+
+        // Update the crosshair, spanning the display volume.
+        if (crosshairEnabled_)
         {
-            xAxis_->shiftLimitsByPixels(lastMousePosition_.x() - event->x());
-            yAxis_->shiftLimitsByPixels(event->y() - lastMousePosition_.y());
-            updateTransforms();
+            auto x = float(pos.x()) - metrics_.displayVolumeOrigin().x();
+            auto y = height() - float(pos.y()) - metrics_.displayVolumeOrigin().y();
+            auto extent = metrics_.displayVolumeExtent();
+            crosshairEntity_->addVertices({{x, 0.0f, 0.05f}, {x, extent.y(), 0.05f}, {0.0f, y, 0.05f}, {extent.x(), y, 0.05f}});
+            crosshairEntity_->setBasicIndices();
+            crosshairEntity_->finalise();
         }
-    }
+        crosshairEntity_->setEnabled(crosshairEnabled_);
 
-    lastMousePosition_ = QPoint(event->x(), event->y());
+        // Enable the text entity, to ensure that it is visible.
+        mouseCoordEntity_->setEnabled(true);
 
-    if (flatView_)
-    {
-        // Ensure that mouse is within plot area.
-        if ((event->x() >= metrics_.displayVolumeOrigin().x()) &&
-            (event->x() <= (metrics_.displayVolumeExtent().x() + metrics_.displayVolumeOrigin().x())) &&
-            (height() - event->y() >= metrics_.displayVolumeOrigin().y()) &&
-            (height() - event->y() <= (metrics_.displayVolumeExtent().y() + metrics_.displayVolumeOrigin().y())))
+        if (mouseCoordStyle_ == CoordinateDisplayStyle::FixedAnchor)
         {
-            // Convert mouse position to 2D axes value.
-            auto coords = toAxes2D(QPoint(event->x(), height() - event->y()));
-
-            // Emit signal indicating that mouse coordinates have been changed.
-            emit mouseCoordChanged(coords);
-
-            // Update the mouse coordinates in the text entity.
-            mouseCoordEntity_->setText(QString("%1 %2").arg(coords.x(), 0, 'g', 4).arg(coords.y(), 0, 'g', 4));
-
-            // Enable the text entity, to ensure that it is visible.
-            mouseCoordEntity_->setEnabled(true);
-
-            if (mouseCoordStyle_ == CoordinateDisplayStyle::FixedAnchor)
-            {
-                // Anchor the text entity at the bottom left of the widget.
-                mouseCoordEntity_->setAnchorPosition(
-                    {-metrics_.displayVolumeOrigin().x(), -metrics_.displayVolumeOrigin().y(), 0.1});
-            }
-            else if (mouseCoordStyle_ == CoordinateDisplayStyle::MouseAnchor)
-            {
-                // Anchor the text entity at the mouse cursor.
-                mouseCoordEntity_->setAnchorPosition({float(event->x()) - metrics_.displayVolumeOrigin().x(),
-                                                      height() - float(event->y()) - metrics_.displayVolumeOrigin().y(), 0});
-            }
-            else if (mouseCoordStyle_ == CoordinateDisplayStyle::None)
-            {
-                // Hide the text entity.
-                mouseCoordEntity_->setEnabled(false);
-            }
+            // Anchor the text entity at the bottom left of the widget.
+            mouseCoordEntity_->setAnchorPosition(
+                {-metrics_.displayVolumeOrigin().x(), -metrics_.displayVolumeOrigin().y(), 0.1});
         }
-        else
+        else if (mouseCoordStyle_ == CoordinateDisplayStyle::MouseAnchor)
+        {
+            // Anchor the text entity at the mouse cursor.
+            mouseCoordEntity_->setAnchorPosition({float(pos.x()) - metrics_.displayVolumeOrigin().x(),
+                                                  height() - float(pos.y()) - metrics_.displayVolumeOrigin().y(), 0});
+        }
+        else if (mouseCoordStyle_ == CoordinateDisplayStyle::None)
         {
             // Hide the text entity.
             mouseCoordEntity_->setEnabled(false);
         }
     }
-
-    updateShaderParameters();
+    else
+    {
+        // Hide the text and crosshair entities.
+        mouseCoordEntity_->setEnabled(false);
+        crosshairEntity_->setEnabled(false);
+    }
 }
 
-void MildredWidget::mouseButtonPressed(Qt3DInput::QMouseEvent *event) {}
+//! Apply input accumulated since the last frame
+/*!
+ * Mouse events may arrive several times per frame, so rather than acting on each immediately their effects (rotation, axis
+ * translation and zoom, and cursor position) are accumulated and applied once, at the start of the next frame. Returns the
+ * invalidations resulting from the applied input.
+ */
+MildredWidget::Invalidations MildredWidget::applyPendingInput()
+{
+    Invalidations invalidations;
+    auto input = std::exchange(pendingInput_, PendingInput());
 
-void MildredWidget::mouseButtonReleased(Qt3DInput::QMouseEvent *event) {}
+    ++renderStatistics_.inputUpdatesApplied;
 
-void MildredWidget::mouseWheeled(Qt3DInput::QWheelEvent *event)
-{
-    if (flatView_)
+    // Rotate scene volume (3D)
+    if (!input.rotation.isNull() && !flatView_)
     {
-        const auto sensitivity = 3;
+        viewRotationMatrix_ *= QQuaternion::fromEulerAngles(input.rotation.y(), input.rotation.x(), 0.0);
+        sceneRootTransform_->setRotation(viewRotationMatrix_);
+        invalidations |= Invalidation::Camera;
+    }
+
+    // Translate axis ranges (2D)
+    if (!input.translation.isNull() && flatView_)
+    {
+        xAxis_->shiftLimitsByPixels(-input.translation.x());
+        yAxis_->shiftLimitsByPixels(input.translation.y());
+        invalidations |= Invalidation::Axes;
+    }
 
-        // Determine factor based on wheel amount, and axis deltas based on that
-        auto sign = event->angleDelta().y() > 0 ? 1 : -1;
+    // Zoom axis ranges (2D), one step at a time
+    if (input.zoomSteps != 0 && flatView_)
+    {
+        const auto sensitivity = 3;
         const auto factor = 0.05;
-        auto xDelta = xAxis_->range() * factor * sign;
-        auto yDelta = yAxis_->range() * factor * sign;
-        xAxis_->setLimits(xAxis_->minimum() + xDelta, xAxis_->maximum() - xDelta);
-        yAxis_->setLimits(yAxis_->minimum() + yDelta, yAxis_->maximum() - yDelta);
-
-        // Shift view centre towards current mouse position
-        // -- Get the data-space delta between the centre coordinates of the 2D axes and the current mouse position
-        auto centreDelta = QPoint(event->x(), height() - event->y()) - screen2DCentre();
-        xAxis_->shiftLimitsByPixels(centreDelta.x() / (sign * sensitivity));
-        yAxis_->shiftLimitsByPixels(centreDelta.y() / (sign * sensitivity));
-
-        updateTransforms();
+        auto sign = input.zoomSteps > 0 ? 1 : -1;
+        for (auto n = 0; n < std::abs(input.zoomSteps); ++n)
+        {
+            // Determine axis deltas based on zoom factor
+            auto xDelta = xAxis_->range() * factor * sign;
+            auto yDelta = yAxis_->range() * factor * sign;
+            xAxis_->setLimits(xAxis_->minimum() + xDelta, xAxis_->maximum() - xDelta);
+            yAxis_->setLimits(yAxis_->minimum() + yDelta, yAxis_->maximum() - yDelta);
+
+            // Shift view centre towards current mouse position
+            // -- Get the data-space delta between the centre coordinates of the 2D axes and the current mouse position
+            auto centreDelta = QPoint(input.zoomPosition.x(), height() - input.zoomPosition.y()) - screen2DCentre();
+            xAxis_->shiftLimitsByPixels(centreDelta.x() / (sign * sensitivity));
+            yAxis_->shiftLimitsByPixels(centreDelta.y() / (sign * sensitivity));
+        }
+        invalidations |= Invalidation::Axes;
     }
+
+    if (input.selectionRegionChanged)
+        updateSelectionRegionEntity();
+
+    // Update mouse coordinate display only once the axes are up to date
+    if (input.cursorPosition)
+        updateMouseCoordinates(*input.cursorPosition);
+
+    return invalidations;
+}
+
+void MildredWidget::setMouseCoordStyle(CoordinateDisplayStyle style) { mouseCoordStyle_ = style; }
+
+//! Set whether the mouse crosshair is shown
+/*!
+ * In flat views, optionally draw horizontal and vertical lines through the mouse position, spanning the display volume.
+ */
+void MildredWidget::setCrosshairEnabled(bool enabled)
+{
+    crosshairEnabled_ = enabled;
+
+    if (!crosshairEnabled_ && crosshairEntity_)
+        crosshairEntity_->setEnabled(false);
 }
 
-void MildredWidget::setMouseCoordStyle(CoordinateDisplayStyle style) { mouseCoordStyle_ = style; }
\ No newline at end of file
+//! Return the data point nearest to the specified widget position
+/*!
+ * Find the data point, across all enabled one-dimensional data entities, nearest to the widget position @param pos (in the
+ * usual top-left origin widget coordinates). Distances are measured in pixels, and only points within @param maximumDistance
+ * are considered. The returned point value is in axis coordinates, consistent with toAxes2D(). Queries are only supported for
+ * flat views.
+ */
+std::optional<MildredWidget::DataPoint> MildredWidget::nearestPoint(QPoint pos, double maximumDistance) const
+{
+    if (!flatView_)
+        return std::nullopt;
+
+    auto value = toAxes2D(QPoint(pos.x(), height() - pos.y()));
+
+    std::optional<DataPoint> result;
+    for (auto &[tag, entity] : dataEntities_)
+    {
+        auto *data1D = dynamic_cast<const Data1DEntity *>(entity);
+        if (!data1D || !data1D->isEnabled())
+            continue;
+
+        auto nearest = data1D->nearestPoint(value, result ? result->distance : maximumDistance);
+        if (nearest)
+            result = DataPoint{tag, nearest->first, {data1D->x()[nearest->first], data1D->values()[nearest->first]},
+                               nearest->second};
+    }
+
+    return result;
+}
@@ -0,0 +1,125 @@
+#include "widget.h"
+#include <QEventLoop>
+#include <QOpenGLContext>
+#include <Qt3DRender/QRenderAspect>
+#include <stdexcept>
+
+using namespace Mildred;
+
+//! Create the offscreen aspect engine, framegraph and view-only entities, if not already done
+/*!
+ * Offscreen widgets own their own aspect engine (containing only the render aspect) and render into textures via an offscreen
+ * surface, so no window (or display) is required. The engine is created once and reused for all subsequent images.
+ *
+ * A widget may render either on screen or offscreen, but not both.
+ */
+void MildredWidget::initialiseOffscreenView()
+{
+    if (offscreen_)
+        return;
+
+    if (viewWindow_)
+    {
+        printf("Widget has already been shown on screen, so can't render offscreen.\n");
+        throw(std::runtime_error("Offscreen rendering requested for on-screen widget.\n"));
+    }
+
+    offscreen_ = true;
+
+    // Create a surface to provide a context for the renderer, requesting the same format as Qt3DWindow does
+    auto format = QSurfaceFormat::defaultFormat();
+    if (QOpenGLContext::openGLModuleType() == QOpenGLContext::LibGL)
+    {
+        format.setVersion(4, 3);
+        format.setProfile(QSurfaceFormat::CoreProfile);
+    }
+    format.setDepthBufferSize(24);
+    offscreenSurface_.reset(new QOffscreenSurface);
+    offscreenSurface_->setFormat(format);
+    offscreenSurface_->create();
+
+    // Render settings are attached directly to our root entity, and only render frames when something has changed
+    renderSettings_ = new Qt3DRender::QRenderSettings(rootEntity_.data());
+    renderSettings_->setRenderPolicy(Qt3DRender::QRenderSettings::OnDemand);
+    rootEntity_->addComponent(renderSettings_);
+
+    // Construct a camera
+    camera_ = new Qt3DRender::QCamera(rootEntity_.data());
+    camera_->setPosition(QVector3D(0, 0, 1.0f));
+    camera_->setViewCenter(QVector3D(0, 0, -10.0));
+
+    // Create the framegraph
+    frameGraph_.createOffscreen(renderSettings_, offscreenSurface_.data(), camera_, frameGraphLayers());
+    frameGraph_.setFlat(flatView_);
+
+    // Add entities which are only required for display
+    createViewEntities();
+
+    // Create the aspect engine and set the root entity
+    offscreenEngine_.reset(new Qt3DCore::QAspectEngine);
+    offscreenEngine_->registerAspect(new Qt3DRender::QRenderAspect);
+    offscreenEngine_->setRootEntity(rootEntity_);
+
+    updateViewGeometry();
+    updateViewActivity();
+}
+
+//! Bring the scene up to date for rendering an image of the specified size and resolution
+/*!
+ * The scene is laid out at a logical size corresponding to @param size (in pixels) at 96 DPI, and rendered to a target of the
+ * requested pixel size, so that text and line widths scale with @param dpi. All pending invalidations are processed
+ * immediately.
+ */
+void MildredWidget::prepareImage(QSize size, double dpi)
+{
+    initialiseOffscreenView();
+
+    // Set logical size - since the widget is never shown no resize event is delivered, so update explicitly
+    auto scale = std::max(dpi, 1.0) / 96.0;
+    resize(std::max(1, int(size.width() / scale)), std::max(1, int(size.height() / scale)));
+    offscreenPixelRatio_ = double(size.width()) / width();
+    updateForSize();
+
+    frameGraph_.setTargetSize(size);
+    axesCacheEntity_->setSize(size);
+
+    // Process all pending invalidations now rather than waiting for the frame timer
+    frameTimer_.stop();
+    renderFrame();
+}
+
+//! Return whether the widget renders offscreen
+bool MildredWidget::isOffscreen() const { return offscreen_; }
+
+//! Request an offscreen render of the current scene at the specified size and resolution
+/*!
+ * Render the current scene to an image of @param size pixels at the specified @param dpi, returning the associated reply whose
+ * completed() signal is emitted once the image is available. The caller takes ownership of the reply. The first call switches
+ * the widget to offscreen rendering, after which it must not be shown.
+ */
+Qt3DRender::QRenderCaptureReply *MildredWidget::requestImage(QSize size, double dpi)
+{
+    prepareImage(size, dpi);
+
+    return frameGraph_.renderCapture()->requestCapture();
+}
+
+//! Render the current scene offscreen to an image of the specified size and resolution
+/*!
+ * Render the current scene to an image of @param size pixels at the specified @param dpi, blocking until it is available.
+ */
+QImage MildredWidget::renderImage(QSize size, double dpi)
+{
+    QScopedPointer<Qt3DRender::QRenderCaptureReply> reply(requestImage(size, dpi));
+
+    QEventLoop loop;
+    connect(reply.data(), &Qt3DRender::QRenderCaptureReply::completed, &loop, &QEventLoop::quit);
+    if (!reply->isComplete())
+        loop.exec();
+
+    auto image = reply->image();
+    image.setDotsPerMeterX(qRound(dpi / 0.0254));
+    image.setDotsPerMeterY(qRound(dpi / 0.0254));
+
+    return image;
+}
@@ -0,0 +1,316 @@
+#include "widget.h"
+#include <QPaintEvent>
+#include <cmath>
+
+using namespace Mildred;
+
+/*
+ * Render Backend
+ */
+
+//! Return whether the raster backend is in use for the current view
+/*!
+ * The raster backend only supports flat views of on-screen widgets - 3D views (and offscreen widgets) always use Qt3D.
+ */
+bool MildredWidget::isRasterActive() const { return renderBackend_ == RenderBackend::Raster && flatView_ && !offscreen_; }
+
+//! Update view state following a change in the active backend
+/*!
+ * When the raster backend is active the Qt3D view container is hidden, the framegraph is disabled, and recreation of data
+ * renderables is suspended, since the raster backend draws directly from the stored data.
+ */
+void MildredWidget::updateRenderBackend()
+{
+    auto raster = isRasterActive();
+
+    if (viewContainer_)
+        viewContainer_->setVisible(!raster);
+    if (camera_)
+        frameGraph_.setEnabled(viewActive_ && !raster);
+
+    for (auto &[tag, entity] : dataEntities_)
+        entity->setRenderablesSuspended(!viewActive_ || raster);
+
+    rasterImageDirty_ = true;
+    invalidate(Invalidation::Material);
+    update();
+}
+
+//! Map scaled display volume coordinates to raster coordinates
+QPointF MildredWidget::toRaster(QVector3D v) const
+{
+    return {metrics_.displayVolumeOrigin().x() + v.x(), height() - (metrics_.displayVolumeOrigin().y() + v.y())};
+}
+
+//! Paint the current flat view with the supplied painter, in widget coordinates
+/*!
+ * Draw the x and y axes and all enabled data with @param painter, using the same layout (as defined by the @class
+ * MildredMetrics) and tick generation as the Qt3D backend.
+ */
+void MildredWidget::paintRaster(QPainter &painter) const
+{
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    paintRasterAxes(painter);
+
+    // Data, clipped to the display volume
+    auto extent = metrics_.displayVolumeExtent();
+    painter.save();
+    painter.setClipRect(QRectF(toRaster({0.0, extent.y(), 0.0}), QSizeF(extent.x(), extent.y())));
+    for (auto &[tag, entity] : dataEntities_)
+    {
+        auto *data1D = dynamic_cast<const Data1DEntity *>(entity);
+        if (data1D && data1D->isEnabled())
+            paintRasterData(painter, data1D);
+    }
+    painter.restore();
+}
+
+//! Paint the enabled x and y axes
+void MildredWidget::paintRasterAxes(QPainter &painter) const
+{
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    for (auto *axis : {xAxis_, yAxis_})
+        if (axis->isEnabled())
+            paintRasterAxis(painter, axis);
+}
+
+//! Paint the specified axis
+void MildredWidget::paintRasterAxis(QPainter &painter, const AxisEntity *axis) const
+{
+    // Draw text within the supplied bounding cuboid
+    auto drawText = [&](const Cuboid &cuboid, const QString &text) {
+        painter.drawText(QRectF(toRaster({cuboid.lowerLeftBack().x(), cuboid.upperRightFront().y(), 0.0}),
+                                toRaster({cuboid.upperRightFront().x(), cuboid.lowerLeftBack().y(), 0.0})),
+                         Qt::AlignCenter, text);
+    };
+
+    painter.setPen(QPen(Qt::black, 1.0));
+
+    // Axis bar
+    painter.drawLine(toRaster({}), toRaster(axis->direction() * float(axis->getAxisScale(metrics_))));
+
+    // Ticks and labels
+    painter.setFont(metrics_.axisTickLabelFont());
+    auto tickDirection = axis->tickDirection();
+    for (auto &&[v, label] : axis->ticks())
+    {
+        auto axisPos = axis->to3D(v);
+        painter.drawLine(toRaster(axisPos), toRaster(axisPos + tickDirection * metrics_.tickPixelSize() * (label ? 1.0 : 0.5)));
+
+        if (!label)
+            continue;
+
+        auto text = axis->tickLabel(v);
+        auto labelPosition = axisPos + tickDirection * (metrics_.tickPixelSize() + metrics_.tickLabelPixelGap());
+        drawText(TextEntity::boundingCuboid(metrics_.axisTickLabelFont(), text, labelPosition, axis->labelAnchorPoint()).first,
+                 text);
+    }
+
+    // Title
+    if (!axis->titleText().isEmpty())
+    {
+        painter.setFont(metrics_.axisTitleFont());
+        drawText(TextEntity::boundingCuboid(metrics_.axisTitleFont(), axis->titleText(), axis->titleAnchorPosition(),
+                                            axis->labelAnchorPoint())
+                     .first,
+                 axis->titleText());
+    }
+}
+
+//! Paint the specified data entity
+void MildredWidget::paintRasterData(QPainter &painter, const Data1DEntity *entity) const
+{
+    const auto &x = entity->x();
+    const auto &values = entity->values();
+    const auto &errors = entity->errors();
+    auto colour = entity->colourDefinition();
+
+    // Only points within (or adjacent to) the current x axis limits need be considered
+    auto [first, last] = entity->indexRange(xAxis_->minimum(), xAxis_->maximum());
+
+    auto toPoint = [&](double xValue, double value) { return toRaster(xAxis_->to3D(xValue) + yAxis_->to3D(value)); };
+    auto isValid = [](QPointF p) { return std::isfinite(p.x()) && std::isfinite(p.y()); };
+
+    // Line - runs of segments with the same colour are drawn as a single polyline
+    if (entity->lineStyle() == StyleFactory1D::Style::Line)
+    {
+        QPolygonF polyline;
+        QColor polylineColour;
+        auto flush = [&]() {
+            if (polyline.size() > 1)
+            {
+                painter.setPen(QPen(polylineColour, 1.0));
+                painter.drawPolyline(polyline);
+            }
+            polyline.clear();
+        };
+        for (auto n = first; n < last; ++n)
+        {
+            auto p = toPoint(x[n], values[n]);
+            if (!isValid(p))
+            {
+                flush();
+                continue;
+            }
+
+            auto pointColour = colour.colour(values[n]);
+            if (pointColour != polylineColour && !polyline.isEmpty())
+            {
+                auto last = polyline.back();
+                flush();
+                polyline << last;
+            }
+            polylineColour = pointColour;
+            polyline << p;
+        }
+        flush();
+    }
+
+    // Error bars
+    if (entity->errorStyle() != StyleFactory1D::ErrorBarStyle::None && errors.size() == values.size())
+    {
+        auto w = entity->errorBarMetric() / 2.0;
+        for (auto n = first; n < last; ++n)
+        {
+            auto upper = toPoint(x[n], values[n] + errors[n]), lower = toPoint(x[n], values[n] - errors[n]);
+            if (!isValid(upper) || !isValid(lower))
+                continue;
+
+            painter.setPen(QPen(colour.colour(values[n]), 1.0));
+            painter.drawLine(upper, lower);
+            if (entity->errorStyle() == StyleFactory1D::ErrorBarStyle::Tee)
+            {
+                painter.drawLine(upper - QPointF(w, 0.0), upper + QPointF(w, 0.0));
+                painter.drawLine(lower - QPointF(w, 0.0), lower + QPointF(w, 0.0));
+            }
+        }
+    }
+
+    // Symbols
+    if (entity->symbolStyle() != StyleFactory1D::SymbolStyle::None)
+    {
+        auto w = entity->symbolMetric() / 2.0;
+        painter.setBrush(Qt::NoBrush);
+        for (auto n = first; n < last; ++n)
+        {
+            auto centre = toPoint(x[n], values[n]);
+            if (!isValid(centre))
+                continue;
+
+            painter.setPen(QPen(colour.colour(values[n]), 1.0));
+            switch (entity->symbolStyle())
+            {
+                case (StyleFactory1D::SymbolStyle::Circle):
+                    painter.drawEllipse(centre, w, w);
+                    break;
+                case (StyleFactory1D::SymbolStyle::Diamond):
+                    painter.drawPolygon(QPolygonF({centre + QPointF(-w, 0.0), centre + QPointF(0.0, -w),
+                                                   centre + QPointF(w, 0.0), centre + QPointF(0.0, w)}));
+                    break;
+                case (StyleFactory1D::SymbolStyle::Square):
+                    painter.drawRect(QRectF(centre - QPointF(w, w), centre + QPointF(w, w)));
+                    break;
+                case (StyleFactory1D::SymbolStyle::Triangle):
+                    painter.drawPolygon(QPolygonF({centre + QPointF(-w, -0.755 * w), centre + QPointF(w, -0.755 * w),
+                                                   centre + QPointF(0.0, 0.755 * w)}));
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // Selected points
+    if (!entity->selection().empty())
+    {
+        auto w = selectionPointSize_ / 2.0;
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(selectionColour_);
+        for (auto n : entity->selection())
+        {
+            auto centre = toPoint(x[n], values[n]);
+            if (isValid(centre))
+                painter.drawRect(QRectF(centre - QPointF(w, w), centre + QPointF(w, w)));
+        }
+        painter.setBrush(Qt::NoBrush);
+    }
+}
+
+//! Set render backend
+/*!
+ * Set the backend used to draw flat views. The Qt3D backend (the default) draws the scene with the GPU. The raster backend
+ * draws axes and data directly with QPainter, which is considerably faster under software OpenGL implementations. 3D views are
+ * always drawn with Qt3D, regardless of this setting.
+ */
+void MildredWidget::setRenderBackend(RenderBackend backend)
+{
+    if (renderBackend_ == backend)
+        return;
+
+    renderBackend_ = backend;
+
+    updateRenderBackend();
+}
+
+//! Return render backend
+MildredWidget::RenderBackend MildredWidget::renderBackend() const { return renderBackend_; }
+
+//! Render the current scene with the raster backend to an image of the specified size and resolution
+/*!
+ * Draw the current flat view with the raster backend to an image of @param size pixels at the specified @param dpi. As with
+ * renderImage(), the widget is resized to the logical size of the image, and so this is intended for widgets which are not
+ * shown.
+ */
+QImage MildredWidget::renderRasterImage(QSize size, double dpi)
+{
+    // Set logical size - since the widget is not shown no resize event is delivered, so update explicitly
+    auto scale = std::max(dpi, 1.0) / 96.0;
+    resize(std::max(1, int(size.width() / scale)), std::max(1, int(size.height() / scale)));
+    updateForSize();
+
+    // Process all pending invalidations now rather than waiting for the frame timer
+    frameTimer_.stop();
+    renderFrame();
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    image.setDotsPerMeterX(qRound(dpi / 0.0254));
+    image.setDotsPerMeterY(qRound(dpi / 0.0254));
+
+    QPainter painter(&image);
+    painter.scale(scale, scale);
+    paintRaster(painter);
+
+    return image;
+}
+
+/*
+ * QWidget
+ */
+
+//! Paint widget (raster backend only)
+/*!
+ * When the raster backend is active the scene is drawn to a cached image whenever it has been invalidated, and the image is
+ * then drawn to the widget.
+ */
+void MildredWidget::paintEvent(QPaintEvent *event)
+{
+    if (!isRasterActive())
+        return;
+
+    auto imageSize = size() * devicePixelRatioF();
+    if (rasterImageDirty_ || rasterImage_.size() != imageSize)
+    {
+        rasterImage_ = QImage(imageSize, QImage::Format_ARGB32_Premultiplied);
+        rasterImage_.setDevicePixelRatio(devicePixelRatioF());
+        rasterImage_.fill(Qt::white);
+        QPainter imagePainter(&rasterImage_);
+        paintRaster(imagePainter);
+        rasterImageDirty_ = false;
+    }
+
+    QPainter painter(this);
+    painter.drawImage(0, 0, rasterImage_);
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "classes/datacolumn.h"
 #include "entities/data.h"
+#include "entities/line.h"
 
 namespace Mildred
 {
@@ -27,11 +29,17 @@ class DataRenderer1D
     protected:
     // Colour definition
     ColourDefinition colour_;
+    // Data origin, relative to which vertex positions are generated
+    double xOrigin_{0.0}, valueOrigin_{0.0};
 
     public:
+    // Set data origin
+    void setOrigin(double xOrigin, double valueOrigin);
     // Create entities from the supplied axes and data
-    virtual void create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                        const std::vector<double> &values, const AxisEntity *valueAxis) = 0;
+    virtual void create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis, const DataColumn &values,
+                        const AxisEntity *valueAxis) = 0;
+    // Return line entity containing one vertex per data point (in order), if any
+    virtual LineEntity *pointVertices() { return nullptr; }
 };
 
 //! ErrorRenderer1DBase is the base class for all 1-dimensional error data renderers.
@@ -60,11 +68,15 @@ class ErrorRenderer1D
 
     // Error bar metric
     double errorBarMetric_{6.0};
+    // Data origin, relative to which vertex positions are generated
+    double xOrigin_{0.0}, valueOrigin_{0.0};
 
     public:
+    // Set data origin
+    void setOrigin(double xOrigin, double valueOrigin);
     // Create entities from the supplied axes and data
-    virtual void create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                        const std::vector<double> &values, const std::vector<double> &errors, const AxisEntity *valueAxis) = 0;
+    virtual void create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis, const DataColumn &values,
+                        const DataColumn &errors, const AxisEntity *valueAxis) = 0;
     // Get error bar metric.
     double errorBarMetric() const;
     // Set error bar metric.
@@ -97,11 +109,15 @@ class SymbolRenderer1D
 
     // Symbol metrics
     double symbolMetric_{6.0};
+    // Data origin, relative to which vertex positions are generated
+    double xOrigin_{0.0}, valueOrigin_{0.0};
 
     public:
+    // Set data origin
+    void setOrigin(double xOrigin, double valueOrigin);
     // Create entities from the supplied axes and data
-    virtual void create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                        const std::vector<double> &values, const AxisEntity *valueAxis) = 0;
+    virtual void create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis, const DataColumn &values,
+                        const AxisEntity *valueAxis) = 0;
     // Get symbol metric.
     double symbolMetric() const;
     // Set symbol metric.
@@ -0,0 +1,10 @@
+#include "base.h"
+
+using namespace Mildred;
+
+// Sets the data origin.
+void DataRenderer1D::setOrigin(double xOrigin, double valueOrigin)
+{
+    xOrigin_ = xOrigin;
+    valueOrigin_ = valueOrigin;
+}
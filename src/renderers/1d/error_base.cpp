@@ -6,4 +6,11 @@ using namespace Mildred;
 double ErrorRenderer1D::errorBarMetric() const { return errorBarMetric_; }
 
 // Sets the error bar metric.
-void ErrorRenderer1D::setErrorBarMetric(double errorBarMetric) { errorBarMetric_ = errorBarMetric; }
\ No newline at end of file
+void ErrorRenderer1D::setErrorBarMetric(double errorBarMetric) { errorBarMetric_ = errorBarMetric; }
+
+// Sets the data origin.
+void ErrorRenderer1D::setOrigin(double xOrigin, double valueOrigin)
+{
+    xOrigin_ = xOrigin;
+    valueOrigin_ = valueOrigin;
+}
@@ -14,7 +14,7 @@ class NoErrorRenderer1D : public ErrorRenderer1D
     NoErrorRenderer1D(Qt3DCore::QEntity *rootEntity) : ErrorRenderer1D(rootEntity) {}
     ~NoErrorRenderer1D(){};
 
-    void create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                const std::vector<double> &values, const std::vector<double> &errors, const AxisEntity *valueAxis) override{};
+    void create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis, const DataColumn &values,
+                const DataColumn &errors, const AxisEntity *valueAxis) override{};
 };
 } // namespace Mildred
\ No newline at end of file
@@ -18,9 +18,8 @@ StickErrorRenderer1D::~StickErrorRenderer1D()
  */
 
 // Create entities from the supplied metrics and data
-void StickErrorRenderer1D::create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                                  const std::vector<double> &values, const std::vector<double> &errors,
-                                  const AxisEntity *valueAxis)
+void StickErrorRenderer1D::create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis,
+                                  const DataColumn &values, const DataColumn &errors, const AxisEntity *valueAxis)
 {
     assert(errors_);
     errors_->clear();
@@ -48,12 +47,15 @@ void StickErrorRenderer1D::create(const ColourDefinition &colour, const std::vec
     auto i = 0;
     while (xit != x.end())
     {
+        auto upper = xAxis->toScaled(*xit, xOrigin_) + valueAxis->toScaled(*vit + *eit, valueOrigin_);
+        auto lower = xAxis->toScaled(*xit, xOrigin_) + valueAxis->toScaled(*vit - *eit, valueOrigin_);
+
         // Upper extreme.
-        errors_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit + *eit), colour_.colour(*vit));
+        errors_->addVertex(upper, colour_.colour(*vit));
         errors_->addIndex(i++);
 
         // Lower extreme.
-        errors_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit - *eit), colour_.colour(*vit));
+        errors_->addVertex(lower, colour_.colour(*vit));
         errors_->addIndex(i++);
 
         // Add restart index, to cause line break.
@@ -18,9 +18,8 @@ TeeErrorRenderer1D::~TeeErrorRenderer1D()
  */
 
 // Create entities from the supplied metrics and data
-void TeeErrorRenderer1D::create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                                const std::vector<double> &values, const std::vector<double> &errors,
-                                const AxisEntity *valueAxis)
+void TeeErrorRenderer1D::create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis,
+                                const DataColumn &values, const DataColumn &errors, const AxisEntity *valueAxis)
 {
     assert(errors_);
     errors_->clear();
@@ -48,12 +47,15 @@ void TeeErrorRenderer1D::create(const ColourDefinition &colour, const std::vecto
     auto i = 0;
     while (xit != x.end())
     {
+        auto upper = xAxis->toScaled(*xit, xOrigin_) + valueAxis->toScaled(*vit + *eit, valueOrigin_);
+        auto lower = xAxis->toScaled(*xit, xOrigin_) + valueAxis->toScaled(*vit - *eit, valueOrigin_);
+
         // Upper extreme.
-        errors_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit + *eit), colour_.colour(*vit));
+        errors_->addVertex(upper, colour_.colour(*vit));
         errors_->addIndex(i++);
 
         // Lower extreme.
-        errors_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit - *eit), colour_.colour(*vit));
+        errors_->addVertex(lower, colour_.colour(*vit));
         errors_->addIndex(i++);
 
         // Add restart index, to cause line break.
@@ -61,24 +63,20 @@ void TeeErrorRenderer1D::create(const ColourDefinition &colour, const std::vecto
 
         // Upper T bar.
         // Offset x of vertex by +errorBarMetric_ / 2.
-        errors_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit + *eit) + QVector3D(errorBarMetric() / 2.0, 0, 0),
-                           colour_.colour(*vit));
+        errors_->addVertex(upper + QVector3D(errorBarMetric() / 2.0, 0, 0), colour_.colour(*vit));
         errors_->addIndex(i++);
         // Offset x of vertex by -errorBarMetric_ / 2.
-        errors_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit + *eit) + QVector3D(-errorBarMetric() / 2.0, 0, 0),
-                           colour_.colour(*vit));
+        errors_->addVertex(upper + QVector3D(-errorBarMetric() / 2.0, 0, 0), colour_.colour(*vit));
         errors_->addIndex(i++);
         // Add restart index, to cause line break.
         errors_->addIndex(-1);
 
         // Lower T bar.
         // Offset x of vertex by +errorBarMetric_ / 2.
-        errors_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit - *eit) + QVector3D(errorBarMetric() / 2.0, 0, 0),
-                           colour_.colour(*vit));
+        errors_->addVertex(lower + QVector3D(errorBarMetric() / 2.0, 0, 0), colour_.colour(*vit));
         errors_->addIndex(i++);
         // Offset x of vertex by -errorBarMetric_ / 2.
-        errors_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit - *eit) + QVector3D(-errorBarMetric() / 2.0, 0, 0),
-                           colour_.colour(*vit));
+        errors_->addVertex(lower + QVector3D(-errorBarMetric() / 2.0, 0, 0), colour_.colour(*vit));
         errors_->addIndex(i++);
         // Add restart index, to cause line break.
         errors_->addIndex(-1);
@@ -24,7 +24,7 @@ class TeeErrorRenderer1D : public ErrorRenderer1D
 
     public:
     // Create entities from the supplied metrics and data
-    void create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                const std::vector<double> &values, const std::vector<double> &errors, const AxisEntity *valueAxis) override;
+    void create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis, const DataColumn &values,
+                const DataColumn &errors, const AxisEntity *valueAxis) override;
 };
 } // namespace Mildred
\ No newline at end of file
@@ -18,8 +18,8 @@ LineRenderer1D::~LineRenderer1D()
  */
 
 // Create entities from the supplied metrics and data
-void LineRenderer1D::create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                            const std::vector<double> &values, const AxisEntity *valueAxis)
+void LineRenderer1D::create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis,
+                            const DataColumn &values, const AxisEntity *valueAxis)
 {
     assert(lines_);
     lines_->clear();
@@ -30,7 +30,7 @@ void LineRenderer1D::create(const ColourDefinition &colour, const std::vector<do
     auto xit = x.cbegin(), vit = values.cbegin();
     while (xit != x.end())
     {
-        lines_->addVertex(xAxis->toScaled(*xit) + valueAxis->toScaled(*vit), colour_.colour(*vit));
+        lines_->addVertex(xAxis->toScaled(*xit, xOrigin_) + valueAxis->toScaled(*vit, valueOrigin_), colour_.colour(*vit));
         ++xit;
         ++vit;
     }
@@ -41,3 +41,6 @@ void LineRenderer1D::create(const ColourDefinition &colour, const std::vector<do
     // Finalise the entity
     lines_->finalise();
 }
+
+// Return line entity containing one vertex per data point (in order)
+LineEntity *LineRenderer1D::pointVertices() { return lines_; }
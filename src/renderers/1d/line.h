@@ -24,7 +24,9 @@ class LineRenderer1D : public DataRenderer1D
 
     public:
     // Create entities from the supplied metrics and data
-    void create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                const std::vector<double> &values, const AxisEntity *valueAxis) override;
+    void create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis, const DataColumn &values,
+                const AxisEntity *valueAxis) override;
+    // Return line entity containing one vertex per data point (in order)
+    LineEntity *pointVertices() override;
 };
 } // namespace Mildred
\ No newline at end of file
@@ -7,3 +7,10 @@ double SymbolRenderer1D::symbolMetric() const { return symbolMetric_; }
 
 // Sets the symbol metric.
 void SymbolRenderer1D::setSymbolMetric(double symbolMetric) { symbolMetric_ = symbolMetric; }
+
+// Sets the data origin.
+void SymbolRenderer1D::setOrigin(double xOrigin, double valueOrigin)
+{
+    xOrigin_ = xOrigin;
+    valueOrigin_ = valueOrigin;
+}
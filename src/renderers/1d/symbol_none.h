@@ -14,7 +14,7 @@ class NoSymbolRenderer1D : public SymbolRenderer1D
     NoSymbolRenderer1D(Qt3DCore::QEntity *rootEntity) : SymbolRenderer1D(rootEntity) {}
     ~NoSymbolRenderer1D(){};
 
-    void create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                const std::vector<double> &values, const AxisEntity *valueAxis) override{};
+    void create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis, const DataColumn &values,
+                const AxisEntity *valueAxis) override{};
 };
 } // namespace Mildred
\ No newline at end of file
@@ -18,8 +18,8 @@ SquareSymbolRenderer1D::~SquareSymbolRenderer1D()
  */
 
 // Create entities from the supplied metrics and data
-void SquareSymbolRenderer1D::create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                                    const std::vector<double> &values, const AxisEntity *valueAxis)
+void SquareSymbolRenderer1D::create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis,
+                                    const DataColumn &values, const AxisEntity *valueAxis)
 {
     assert(symbols_);
     symbols_->clear();
@@ -41,7 +41,7 @@ void SquareSymbolRenderer1D::create(const ColourDefinition &colour, const std::v
     while (xit != x.end())
     {
         // Get datapoint value in scaled coordinates
-        auto centre = xAxis->toScaled(*xit) + valueAxis->toScaled(*vit);
+        auto centre = xAxis->toScaled(*xit, xOrigin_) + valueAxis->toScaled(*vit, valueOrigin_);
 
         // Square Vertices
         symbols_->addVertex(centre + QVector3D(-w, w, 0.0), colour_.colour(*vit));
@@ -24,8 +24,8 @@ class SquareSymbolRenderer1D : public SymbolRenderer1D
 
     public:
     // Create entities from the supplied metrics and data
-    void create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                const std::vector<double> &values, const AxisEntity *valueAxis) override;
+    void create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis, const DataColumn &values,
+                const AxisEntity *valueAxis) override;
 };
 
 } // namespace Mildred
@@ -18,8 +18,8 @@ TriangleSymbolRenderer1D::~TriangleSymbolRenderer1D()
  */
 
 // Create entities from the supplied metrics and data
-void TriangleSymbolRenderer1D::create(const ColourDefinition &colour, const std::vector<double> &x, const AxisEntity *xAxis,
-                                      const std::vector<double> &values, const AxisEntity *valueAxis)
+void TriangleSymbolRenderer1D::create(const ColourDefinition &colour, const DataColumn &x, const AxisEntity *xAxis,
+                                      const DataColumn &values, const AxisEntity *valueAxis)
 {
     assert(symbols_);
     symbols_->clear();
@@ -41,7 +41,7 @@ void TriangleSymbolRenderer1D::create(const ColourDefinition &colour, const std:
     while (xit != x.end())
     {
         // Get datapoint value in scaled coordinates
-        auto centre = xAxis->toScaled(*xit) + valueAxis->toScaled(*vit);
+        auto centre = xAxis->toScaled(*xit, xOrigin_) + valueAxis->toScaled(*vit, valueOrigin_);
 
         // Triangle Vertices
         symbols_->addVertex(centre + QVector3D(-w, 0.755 * w, 0.0), colour_.colour(*vit));
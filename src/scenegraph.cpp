@@ -3,6 +3,7 @@
 #include "widget.h"
 #include <Qt3DExtras/QCuboidMesh>
 #include <Qt3DRender/QPointLight>
+#include <QtMath>
 
 using namespace Mildred;
 
@@ -20,115 +21,187 @@ using namespace Mildred;
  *               |         |    |
  * sceneObjectsTransform_  |    |      Places scene objects so that global 0,0,0 is lower left corner to the viewer
  *                         |    |
- *                 axesEntity   |      Contains the individual AxesEntities
+ *                axesEntity_   |      Contains the individual AxesEntities, tagged (recursively) with axesLayer_
  *                     |        |
- *           xAxis_,yAxis_...   |      Individual axis entities
+ *           xAxis_,yAxis_...   |      Individual axis entities (zAxis_ is created on first request)
+ *                              |
+ *                 dataRootEntity_     Tagged (recursively) with dataLayer_ so data can be drawn separately
  *                              |
  *                      dataEntity     Parent entity for all displayed data series
  *                       |      |
- *      dataOriginTransform_    *      Sets the coordinate system so that 0,0,0 is at the axes origin
+ *      dataOriginTransform_    *      Offsets data along the depth axis - data entities place themselves relative
+ *                                     to the x and y axes, so that 0,0,0 is at the axes origin
  */
 void MildredWidget::createSceneGraph()
 {
-    auto *lightEntity = new Qt3DCore::QEntity(rootEntity_.data());
-
-    auto *light = new Qt3DRender::QPointLight(lightEntity);
-    light->setColor("white");
-    light->setIntensity(1);
-    lightEntity->addComponent(light);
-
-    auto *lightTransform = new Qt3DCore::QTransform(lightEntity);
-    lightTransform->setTranslation(lightPosition_);
-    lightEntity->addComponent(lightTransform);
-
     sceneRootEntity_ = new Qt3DCore::QEntity(rootEntity_.data());
     sceneRootTransform_ = new Qt3DCore::QTransform(sceneRootEntity_);
     sceneRootEntity_->addComponent(sceneRootTransform_);
 
-    auto *sceneObjectsEntity_ = new Qt3DCore::QEntity(sceneRootEntity_);
+    sceneObjectsEntity_ = new Qt3DCore::QEntity(sceneRootEntity_);
     sceneObjectsTransform_ = new Qt3DCore::QTransform(sceneObjectsEntity_);
     sceneObjectsEntity_->addComponent(sceneObjectsTransform_);
 
-    // Debug
-    sceneBoundingCuboidEntity_ = new Qt3DCore::QEntity(sceneRootEntity_);
-    sceneBoundingCuboidEntity_->setEnabled(false);
-    auto *cuboidMesh = new Qt3DExtras::QCuboidMesh(sceneBoundingCuboidEntity_);
-    sceneBoundingCuboidEntity_->addComponent(cuboidMesh);
-    sceneBoundingCuboidTransform_ = new Qt3DCore::QTransform(sceneBoundingCuboidEntity_);
-    sceneBoundingCuboidEntity_->addComponent(sceneBoundingCuboidTransform_);
-    auto *cuboidMaterial =
-        createMaterial(sceneBoundingCuboidEntity_, RenderableMaterial::VertexShaderType::Unclipped,
-                       RenderableMaterial::GeometryShaderType::LineTesselator, RenderableMaterial::FragmentShaderType::Phong);
-    cuboidMaterial->setAmbient(QColor(255, 0, 0, 255));
-    sceneBoundingCuboidEntity_->addComponent(cuboidMaterial);
-
     /*
      * Axes Leaf
      */
 
-    auto *axesEntity = new Qt3DCore::QEntity(sceneObjectsEntity_);
+    axesEntity_ = new Qt3DCore::QEntity(sceneObjectsEntity_);
+    axesLayer_ = new Qt3DRender::QLayer(axesEntity_);
+    axesLayer_->setRecursive(true);
+    axesEntity_->addComponent(axesLayer_);
 
-    auto *xAxisBarMaterial = createMaterial(axesEntity, RenderableMaterial::VertexShaderType::Unclipped,
+    auto *xAxisBarMaterial = createMaterial(axesEntity_, RenderableMaterial::VertexShaderType::Unclipped,
                                             RenderableMaterial::GeometryShaderType::LineTesselator,
                                             RenderableMaterial::FragmentShaderType::Monochrome);
     xAxisBarMaterial->setAmbient(QColor(0, 0, 0, 255));
     auto *xAxisLabelMaterial =
-        createMaterial(axesEntity, RenderableMaterial::VertexShaderType::Unclipped,
+        createMaterial(axesEntity_, RenderableMaterial::VertexShaderType::Unclipped,
                        RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Monochrome);
     xAxisLabelMaterial->setAmbient(QColor(0, 0, 0, 255));
-    xAxis_ = new AxisEntity(axesEntity, AxisEntity::AxisType::Horizontal, metrics_, xAxisBarMaterial, xAxisLabelMaterial);
+    xAxis_ = new AxisEntity(axesEntity_, AxisEntity::AxisType::Horizontal, metrics_, xAxisBarMaterial, xAxisLabelMaterial);
     xAxis_->setTitleText("X");
+    xAxis_->setGeometryEnabled(!flatView_);
     connect(xAxis_, SIGNAL(enabledChanged(bool)), this, SLOT(updateMetrics()));
     connect(xAxis_, SIGNAL(rangeChanged()), this, SLOT(updateMetrics()));
+    connect(xAxis_, &AxisEntity::limitsChanged, this, [this]() { invalidate(Invalidation::Axes); });
+    connect(xAxis_, &AxisEntity::recreated, this, [this]() { axesCacheDirty_ = true; });
 
-    auto *yAxisBarMaterial = createMaterial(axesEntity, RenderableMaterial::VertexShaderType::Unclipped,
+    auto *yAxisBarMaterial = createMaterial(axesEntity_, RenderableMaterial::VertexShaderType::Unclipped,
                                             RenderableMaterial::GeometryShaderType::LineTesselator,
                                             RenderableMaterial::FragmentShaderType::Monochrome);
     yAxisBarMaterial->setAmbient(QColor(0, 0, 0, 255));
     auto *yAxisLabelMaterial =
-        createMaterial(axesEntity, RenderableMaterial::VertexShaderType::Unclipped,
+        createMaterial(axesEntity_, RenderableMaterial::VertexShaderType::Unclipped,
                        RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Monochrome);
     yAxisLabelMaterial->setAmbient(QColor(0, 0, 0, 255));
-    yAxis_ = new AxisEntity(axesEntity, AxisEntity::AxisType::Vertical, metrics_, yAxisBarMaterial, yAxisLabelMaterial);
+    yAxis_ = new AxisEntity(axesEntity_, AxisEntity::AxisType::Vertical, metrics_, yAxisBarMaterial, yAxisLabelMaterial);
     yAxis_->setTitleText("Y");
+    yAxis_->setGeometryEnabled(!flatView_);
     connect(yAxis_, SIGNAL(enabledChanged(bool)), this, SLOT(updateMetrics()));
     connect(yAxis_, SIGNAL(rangeChanged()), this, SLOT(updateMetrics()));
-
-    auto *zAxisBarMaterial = createMaterial(axesEntity, RenderableMaterial::VertexShaderType::Unclipped,
-                                            RenderableMaterial::GeometryShaderType::LineTesselator,
-                                            RenderableMaterial::FragmentShaderType::Monochrome);
-    zAxisBarMaterial->setAmbient(QColor(0, 0, 0, 255));
-    auto *zAxisLabelMaterial =
-        createMaterial(axesEntity, RenderableMaterial::VertexShaderType::Unclipped,
-                       RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Monochrome);
-    zAxisLabelMaterial->setAmbient(QColor(0, 0, 0, 255));
-    zAxis_ = new AxisEntity(axesEntity, AxisEntity::AxisType::Depth, metrics_, zAxisBarMaterial, zAxisLabelMaterial);
-    zAxis_->setTitleText("Z");
-    connect(zAxis_, SIGNAL(enabledChanged(bool)), this, SLOT(updateMetrics()));
-    connect(zAxis_, SIGNAL(rangeChanged()), this, SLOT(updateMetrics()));
-    zAxis_->setEnabled(false);
+    connect(yAxis_, &AxisEntity::limitsChanged, this, [this]() { invalidate(Invalidation::Axes); });
+    connect(yAxis_, &AxisEntity::recreated, this, [this]() { axesCacheDirty_ = true; });
 
     /*
      * Data Space Leaf
      */
 
     dataRootEntity_ = new Qt3DCore::QEntity(sceneObjectsEntity_);
+    dataLayer_ = new Qt3DRender::QLayer(dataRootEntity_);
+    dataLayer_->setRecursive(true);
+    dataRootEntity_->addComponent(dataLayer_);
+
+    // Layer for the axes cache, created along with the view
+    axesCacheLayer_ = new Qt3DRender::QLayer(rootEntity_.data());
     dataEntityParent_ = new Qt3DCore::QEntity(dataRootEntity_);
     dataOriginTransform_ = new Qt3DCore::QTransform(dataEntityParent_);
     dataEntityParent_->addComponent(dataOriginTransform_);
+}
+
+//! Create entities required only for display
+/*!
+ * Create the light, debug bounding cuboid, mouse coordinate and crosshair, selection region, and axes cache entities, none of
+ * which are required until the widget is shown.
+ */
+void MildredWidget::createViewEntities()
+{
+    auto *lightEntity = new Qt3DCore::QEntity(rootEntity_.data());
+
+    auto *light = new Qt3DRender::QPointLight(lightEntity);
+    light->setColor("white");
+    light->setIntensity(1);
+    lightEntity->addComponent(light);
+
+    auto *lightTransform = new Qt3DCore::QTransform(lightEntity);
+    lightTransform->setTranslation(lightPosition_);
+    lightEntity->addComponent(lightTransform);
+
+    // Debug
+    sceneBoundingCuboidEntity_ = new Qt3DCore::QEntity(sceneRootEntity_);
+    sceneBoundingCuboidEntity_->setEnabled(sceneCuboidEnabled_);
+    auto *cuboidMesh = new Qt3DExtras::QCuboidMesh(sceneBoundingCuboidEntity_);
+    sceneBoundingCuboidEntity_->addComponent(cuboidMesh);
+    sceneBoundingCuboidTransform_ = new Qt3DCore::QTransform(sceneBoundingCuboidEntity_);
+    sceneBoundingCuboidEntity_->addComponent(sceneBoundingCuboidTransform_);
+    // -- The cuboid is a triangle mesh, so its material is not subject to the line render mode
+    RenderableMaterial::ShaderCombination cuboidShaders{RenderableMaterial::VertexShaderType::Unclipped,
+                                                        RenderableMaterial::GeometryShaderType::LineTesselator,
+                                                        RenderableMaterial::FragmentShaderType::Phong};
+    auto *cuboidMaterial = new RenderableMaterial(sceneBoundingCuboidEntity_, effect(cuboidShaders), cuboidShaders);
+    cuboidMaterial->setAmbient(QColor(255, 0, 0, 255));
+    sceneBoundingCuboidEntity_->addComponent(cuboidMaterial);
 
-    // Create mouse coord entity
+    // Create mouse coord entity - drawn from a glyph atlas, since it changes with every mouse movement
+    mouseCoordEntity_ = new GlyphTextEntity(sceneObjectsEntity_, QFont("monospace", 10.0));
     auto *mouseCoordLabelMaterial =
-        createMaterial(sceneObjectsEntity_, RenderableMaterial::VertexShaderType::Unclipped,
-                       RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Monochrome);
+        createMaterial(mouseCoordEntity_, RenderableMaterial::VertexShaderType::Glyph,
+                       RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Glyph);
     mouseCoordLabelMaterial->setAmbient(QColor(0, 0, 0, 255));
-    mouseCoordEntity_ = new TextEntity(sceneObjectsEntity_, QString("0.0, 0.0"));
-    mouseCoordEntity_->setMaterial(mouseCoordLabelMaterial);
-    mouseCoordEntity_->setFont(QFont("monospace", 10.0));
+    mouseCoordLabelMaterial->addParameter(
+        new Qt3DRender::QParameter(QStringLiteral("glyphTexture"), mouseCoordEntity_->texture()));
     mouseCoordEntity_->setAnchorPoint(MildredMetrics::AnchorPoint::BottomLeft);
     mouseCoordEntity_->setEnabled(false);
+
+    // Create mouse crosshair entity
+    crosshairEntity_ = new LineEntity(sceneObjectsEntity_, Qt3DRender::QGeometryRenderer::Lines);
+    auto *crosshairMaterial =
+        createMaterial(crosshairEntity_, RenderableMaterial::VertexShaderType::Unclipped,
+                       RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Monochrome);
+    crosshairMaterial->setAmbient(QColor(128, 128, 128, 255));
+    crosshairEntity_->setEnabled(false);
+
+    // Create selection region entity
+    selectionRegionEntity_ = new LineEntity(sceneObjectsEntity_, Qt3DRender::QGeometryRenderer::LineStrip);
+    auto *selectionRegionMaterial =
+        createMaterial(selectionRegionEntity_, RenderableMaterial::VertexShaderType::Unclipped,
+                       RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Monochrome);
+    selectionRegionMaterial->setAmbient(selectionColour_);
+
+    // Create axes cache, drawn in place of the axes in flat views
+    axesCacheEntity_ = new LayerCacheEntity(rootEntity_.data());
+    axesCacheEntity_->addComponent(axesCacheLayer_);
+    auto *axesCacheMaterial =
+        createMaterial(axesCacheEntity_, RenderableMaterial::VertexShaderType::ScreenQuad,
+                       RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Texture);
+    axesCacheMaterial->addParameter(new Qt3DRender::QParameter(QStringLiteral("layerTexture"), axesCacheEntity_->texture()));
+    axesCacheEntity_->setPaintFunction([this](QPainter &painter) {
+        painter.fillRect(QRect(0, 0, painter.device()->width(), painter.device()->height()), Qt::white);
+        painter.scale(renderPixelRatio(), renderPixelRatio());
+        paintRasterAxes(painter);
+    });
+}
+
+//! Create the z axis
+/*!
+ * The depth axis is only required for 3D views, and so is created (along with its materials) on first request.
+ */
+void MildredWidget::createZAxis()
+{
+    assert(!zAxis_);
+
+    auto *zAxisBarMaterial = createMaterial(axesEntity_, RenderableMaterial::VertexShaderType::Unclipped,
+                                            RenderableMaterial::GeometryShaderType::LineTesselator,
+                                            RenderableMaterial::FragmentShaderType::Monochrome);
+    zAxisBarMaterial->setAmbient(QColor(0, 0, 0, 255));
+    auto *zAxisLabelMaterial =
+        createMaterial(axesEntity_, RenderableMaterial::VertexShaderType::Unclipped,
+                       RenderableMaterial::GeometryShaderType::None, RenderableMaterial::FragmentShaderType::Monochrome);
+    zAxisLabelMaterial->setAmbient(QColor(0, 0, 0, 255));
+    zAxis_ = new AxisEntity(axesEntity_, AxisEntity::AxisType::Depth, metrics_, zAxisBarMaterial, zAxisLabelMaterial);
+    zAxis_->setTitleText("Z");
+    zAxis_->setEnabled(!flatView_);
+    connect(zAxis_, SIGNAL(enabledChanged(bool)), this, SLOT(updateMetrics()));
+    connect(zAxis_, SIGNAL(rangeChanged()), this, SLOT(updateMetrics()));
+    connect(zAxis_, &AxisEntity::recreated, this, [this]() { axesCacheDirty_ = true; });
 }
 
+//! Return scaled position of the data axes origin along the depth axis
+QVector3D MildredWidget::dataDepthOrigin() const { return zAxis_ ? zAxis_->toScaled(zAxis_->minimum()) : QVector3D(); }
+
+//! Return framegraph layers
+MildredFrameGraph::Layers MildredWidget::frameGraphLayers() const { return {dataLayer_, axesLayer_, axesCacheLayer_}; }
+
 //! Convert widget position to 2D (flat) coordinates
 QPointF MildredWidget::toAxes2D(QPoint pos) const
 {
@@ -149,8 +222,14 @@ AxisEntity *MildredWidget::xAxis() { return xAxis_; }
 //! Return y axis entity
 AxisEntity *MildredWidget::yAxis() { return yAxis_; }
 
-//! Return z axis entity
-AxisEntity *MildredWidget::zAxis() { return zAxis_; }
+//! Return z axis entity, creating it if necessary
+AxisEntity *MildredWidget::zAxis()
+{
+    if (!zAxis_)
+        createZAxis();
+
+    return zAxis_;
+}
 
 //! Update transforms from metrics
 /*!
@@ -164,8 +243,15 @@ void MildredWidget::updateTransforms()
         sceneObjectsTransform_->setTranslation(metrics_.displayVolumeOrigin() -
                                                QVector3D(width() / 2.0, height() / 2.0, -width() / 2.0));
     if (dataOriginTransform_)
-        dataOriginTransform_->setTranslation(
-            -(xAxis_->toScaled(xAxis_->minimum()) + yAxis_->toScaled(yAxis_->minimum()) + zAxis_->toScaled(zAxis_->minimum())));
+        dataOriginTransform_->setTranslation(-dataDepthOrigin());
+
+    // Data entities place their own (double-precision) origins relative to the x and y axes origin
+    for (auto &[tag, entity] : dataEntities_)
+    {
+        auto *data1D = dynamic_cast<Data1DEntity *>(entity);
+        if (data1D)
+            data1D->updateOriginTransform();
+    }
 }
 
 //! Update shader parameters
@@ -174,16 +260,23 @@ void MildredWidget::updateTransforms()
  */
 void MildredWidget::updateShaderParameters()
 {
+    auto zDirection = zAxis_ ? zAxis_->direction() : QVector3D(0.0, 0.0, -1.0);
     sceneDataAxesParameter_->setValue(QMatrix4x4(xAxis_->direction().x(), xAxis_->direction().y(), xAxis_->direction().z(), 0.0,
                                                  yAxis_->direction().x(), yAxis_->direction().y(), yAxis_->direction().z(), 0.0,
-                                                 zAxis_->direction().x(), zAxis_->direction().y(), zAxis_->direction().z(), 0.0,
-                                                 0.0, 0.0, 0.0, 1.0));
+                                                 zDirection.x(), zDirection.y(), zDirection.z(), 0.0, 0.0, 0.0, 0.0, 1.0));
     sceneDataAxesExtentsParameter_->setValue(metrics_.displayVolumeExtent());
-    sceneDataAxesOriginParameter_->setValue(xAxis_->toScaled(xAxis_->minimum()) + yAxis_->toScaled(yAxis_->minimum()) +
-                                            zAxis_->toScaled(zAxis_->minimum()));
     sceneDataTransformInverseParameter_->setValue(
-        (sceneRootTransform_->matrix() * sceneObjectsTransform_->matrix() * dataOriginTransform_->matrix()).inverted());
+        (sceneRootTransform_->matrix() * sceneObjectsTransform_->matrix()).inverted());
     viewportSizeParameter_->setValue(QVector2D(width(), height()));
+
+    // Clip data in flat views to the display volume, in render target pixels
+    if (camera_ && flatView_)
+    {
+        auto ratio = renderPixelRatio();
+        auto origin = metrics_.displayVolumeOrigin(), extent = metrics_.displayVolumeExtent();
+        frameGraph_.setDataScissorRect(QRect(qFloor(origin.x() * ratio), qFloor(origin.y() * ratio),
+                                             qCeil(extent.x() * ratio), qCeil(extent.y() * ratio)));
+    }
 }
 
 //! Reset view
@@ -197,7 +290,7 @@ void MildredWidget::resetView()
     viewRotationMatrix_ = QQuaternion();
     sceneRootTransform_->setRotation(viewRotationMatrix_);
 
-    updateShaderParameters();
+    invalidate(Invalidation::Camera);
 }
 
 //! Show all data in view
@@ -224,7 +317,7 @@ void MildredWidget::showAllData()
     if (yAxis_->isLogarithmic() && logarithmicExtrema.validYExtent())
         extrema.setYExtent(pow(10.0, logarithmicExtrema.lowerLeftBack().y()),
                            pow(10.0, logarithmicExtrema.upperRightFront().y()));
-    if (zAxis_->isLogarithmic() && logarithmicExtrema.validZExtent())
+    if (zAxis_ && zAxis_->isLogarithmic() && logarithmicExtrema.validZExtent())
         extrema.setZExtent(pow(10.0, logarithmicExtrema.lowerLeftBack().z()),
                            pow(10.0, logarithmicExtrema.upperRightFront().z()));
 
@@ -239,7 +332,8 @@ void MildredWidget::showAllData()
 
     xAxis_->setLimits(extrema.lowerLeftBack().x(), extrema.upperRightFront().x());
     yAxis_->setLimits(extrema.lowerLeftBack().y(), extrema.upperRightFront().y());
-    zAxis_->setLimits(extrema.lowerLeftBack().z(), extrema.upperRightFront().z());
+    if (zAxis_)
+        zAxis_->setLimits(extrema.lowerLeftBack().z(), extrema.upperRightFront().z());
 
     updateMetrics();
 }
@@ -272,8 +366,7 @@ void MildredWidget::setYAxisTitle(const QString &title)
  */
 void MildredWidget::setZAxisTitle(const QString &title)
 {
-    assert(zAxis_);
-    zAxis_->setTitleText(title);
+    zAxis()->setTitleText(title);
     updateMetrics();
 }
 
@@ -283,6 +376,9 @@ void MildredWidget::setZAxisTitle(const QString &title)
  */
 void MildredWidget::setSceneCuboidEnabled(bool enabled)
 {
-    assert(sceneBoundingCuboidEntity_);
-    sceneBoundingCuboidEntity_->setEnabled(enabled);
+    sceneCuboidEnabled_ = enabled;
+    if (sceneBoundingCuboidEntity_)
+        sceneBoundingCuboidEntity_->setEnabled(sceneCuboidEnabled_);
+
+    invalidate(Invalidation::Material);
 }
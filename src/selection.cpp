@@ -0,0 +1,114 @@
+#include "widget.h"
+
+using namespace Mildred;
+
+/*
+ * Selection
+ */
+
+//! Update the entity showing the region currently being dragged out
+/*!
+ * Draw the outline of the rectangle or lasso currently being dragged out with the mouse, positioned in the same space as the
+ * mouse coordinate label.
+ */
+void MildredWidget::updateSelectionRegionEntity()
+{
+    if (!selectionRegionEntity_)
+        return;
+
+    selectionRegionEntity_->clear();
+    if (selectionRegion_.size() < 2)
+        return;
+
+    auto origin = metrics_.displayVolumeOrigin();
+    auto toScene = [&](QPoint p) { return QVector3D(p.x() - origin.x(), height() - p.y() - origin.y(), 0.1); };
+
+    if (lassoSelection_)
+        for (auto &p : selectionRegion_)
+            selectionRegionEntity_->addVertex(toScene(p));
+    else
+    {
+        QRect rect(selectionRegion_.front(), selectionRegion_.back());
+        selectionRegionEntity_->addVertices(
+            {toScene(rect.topLeft()), toScene(rect.topRight()), toScene(rect.bottomRight()), toScene(rect.bottomLeft())});
+    }
+    selectionRegionEntity_->setBasicIndices();
+    selectionRegionEntity_->addIndex(0);
+    selectionRegionEntity_->finalise();
+}
+
+//! Select data points within the specified axis-space region
+/*!
+ * Set the selection of every enabled one-dimensional data entity to the indices returned by @param query, clearing the
+ * selection of all other entities.
+ */
+void MildredWidget::select(const std::function<std::vector<int>(const Data1DEntity *)> &query)
+{
+    for (auto &[tag, entity] : dataEntities_)
+    {
+        auto *data1D = dynamic_cast<Data1DEntity *>(entity);
+        if (data1D)
+            data1D->setSelection(data1D->isEnabled() ? query(data1D) : std::vector<int>());
+    }
+
+    invalidate(Invalidation::Data);
+
+    emit selectionChanged();
+}
+
+//! Select data points within the specified rectangle (widget coordinates)
+/*!
+ * Select all data points, across all enabled one-dimensional data entities, lying within @param rect (given in the usual
+ * top-left origin widget coordinates). Selection is only supported for flat views.
+ */
+void MildredWidget::selectRectangle(QRect rect)
+{
+    if (!flatView_)
+        return;
+
+    QRectF axesRect(toAxes2D(QPoint(rect.left(), height() - rect.top())),
+                    toAxes2D(QPoint(rect.right(), height() - rect.bottom())));
+
+    select([axesRect](const Data1DEntity *entity) { return entity->pointsInRectangle(axesRect); });
+}
+
+//! Select data points within the specified polygon (widget coordinates)
+/*!
+ * Select all data points, across all enabled one-dimensional data entities, lying within the closed @param polygon (given in
+ * the usual top-left origin widget coordinates). Selection is only supported for flat views.
+ */
+void MildredWidget::selectPolygon(const QPolygon &polygon)
+{
+    if (!flatView_)
+        return;
+
+    QPolygonF axesPolygon;
+    for (auto &p : polygon)
+        axesPolygon << toAxes2D(QPoint(p.x(), height() - p.y()));
+
+    select([&axesPolygon](const Data1DEntity *entity) { return entity->pointsInPolygon(axesPolygon); });
+}
+
+//! Clear selection
+void MildredWidget::clearSelection()
+{
+    select([](const Data1DEntity *) { return std::vector<int>(); });
+}
+
+//! Return indices of selected data points, by data entity tag
+/*!
+ * Return the (ascending) indices of selected data points for every data entity with a non-empty selection.
+ */
+std::vector<std::pair<std::string, std::vector<int>>> MildredWidget::selection() const
+{
+    std::vector<std::pair<std::string, std::vector<int>>> result;
+
+    for (auto &[tag, entity] : dataEntities_)
+    {
+        auto *data1D = dynamic_cast<const Data1DEntity *>(entity);
+        if (data1D && !data1D->selection().empty())
+            result.emplace_back(tag, data1D->selection());
+    }
+
+    return result;
+}
@@ -23,7 +23,6 @@ uniform mat4 modelViewProjection;
 uniform mat4 sceneDataTransformInverse;
 uniform mat4 sceneDataAxes;
 uniform vec3 sceneDataAxesExtents;
-uniform vec3 sceneDataAxesOrigin;
 
 void main()
 {
@@ -37,7 +36,6 @@ void main()
 
     // Transform vertex into "plain" data space
     vec4 dataPosition = sceneDataTransformInverse * vec4(world.position, 1.0);
-    dataPosition.xyz -= sceneDataAxesOrigin;
 
     // Clip vertices to data volume
     // -- X axis
@@ -0,0 +1,39 @@
+#version 150 core
+
+// Per-vertex input variables - corner of the segment quad (x = position along segment, y = side)
+in vec2 quadCorner;
+
+// Per-instance input variables - segment end points and colours
+in vec3 segmentStart;
+in vec4 segmentStartColor;
+in vec3 segmentEnd;
+in vec4 segmentEndColor;
+
+// Output variables
+out vec4 flatColor;
+
+// Standard uniform variables per-primitive
+uniform mat4 modelViewProjection;
+
+// Custom uniforms
+uniform vec2 viewportSize;
+uniform float lineWidth = 1.5;
+
+void main()
+{
+    // Select the end point for this corner
+    bool atEnd = quadCorner.x > 0.5;
+
+    // Project both end points, and determine the offset perpendicular to the segment in clip space
+    vec4 p1 = modelViewProjection * vec4(segmentStart, 1.0);
+    vec4 p2 = modelViewProjection * vec4(segmentEnd, 1.0);
+    vec2 dir = normalize((p2.xy - p1.xy) * viewportSize);
+    vec2 offset = vec2(-dir.y, dir.x) * lineWidth / viewportSize;
+    vec4 p = atEnd ? p2 : p1;
+
+    // Pass vertex colour straight through - no lighting is performed, and clipping is handled by the scissor test
+    flatColor = atEnd ? segmentEndColor : segmentStartColor;
+
+    // Output corner position
+    gl_Position = p + vec4(offset.xy * quadCorner.y * p.w, 0.0, 0.0);
+}
@@ -0,0 +1,20 @@
+#version 150 core
+
+// Input variables
+in vec2 texCoord;
+
+// Uniform variables per-primitive
+// -- Colour components
+uniform vec3 ambient;
+// -- Glyph atlas
+uniform sampler2D glyphTexture;
+
+// Output variables
+out vec4 fragColour;
+
+void main() {
+  // Glyphs are drawn without blending, so discard fragments outside the glyph outline
+  if (texture(glyphTexture, texCoord).a < 0.5)
+    discard;
+  fragColour = vec4(ambient, 1.0);
+}
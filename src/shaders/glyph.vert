@@ -0,0 +1,20 @@
+#version 150 core
+
+// Input variables
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+
+// Output variables
+out vec2 texCoord;
+
+// Standard uniform variables per-primitive
+uniform mat4 modelViewProjection;
+
+void main()
+{
+    // Pass texture coordinate straight through
+    texCoord = vertexTexCoord;
+
+    // Output projected vertex position
+    gl_Position = modelViewProjection * vec4(vertexPosition, 1.0);
+}
@@ -0,0 +1,79 @@
+#version 150 core
+
+// Per-vertex input variables - corner of the segment quad (x = position along segment, y = side)
+in vec2 quadCorner;
+
+// Per-instance input variables - segment end points and colours
+in vec3 segmentStart;
+in vec4 segmentStartColor;
+in vec3 segmentEnd;
+in vec4 segmentEndColor;
+
+// Output Fragment Data
+out fragData
+{
+    vec3 position;
+    vec3 normal;
+    vec4 color;
+}
+frag;
+
+// Standard uniform variables per-primitive
+uniform mat4 modelMatrix;
+uniform mat4 modelViewProjection;
+
+// Custom uniforms
+uniform vec2 viewportSize;
+uniform float lineWidth = 1.5;
+#ifdef CLIP_TO_DATA_VOLUME
+uniform mat4 sceneDataTransformInverse;
+uniform mat4 sceneDataAxes;
+uniform vec3 sceneDataAxesExtents;
+#endif
+
+void main()
+{
+    // Select the end point for this corner
+    bool atEnd = quadCorner.x > 0.5;
+    vec4 vertexPosition4 = vec4(atEnd ? segmentEnd : segmentStart, 1.0);
+
+    // Project both end points, and determine the offset perpendicular to the segment in clip space
+    vec4 p1 = modelViewProjection * vec4(segmentStart, 1.0);
+    vec4 p2 = modelViewProjection * vec4(segmentEnd, 1.0);
+    vec2 dir = normalize((p2.xy - p1.xy) * viewportSize);
+    vec2 offset = vec2(-dir.y, dir.x) * lineWidth / viewportSize;
+    vec4 p = atEnd ? p2 : p1;
+
+#ifdef CLIP_TO_DATA_VOLUME
+    // Transform end point into "plain" data space
+    vec4 dataPosition = sceneDataTransformInverse * (modelMatrix * vertexPosition4);
+
+    // Clip to data volume
+    // -- X axis
+    gl_ClipDistance[0] = dot(dataPosition, sceneDataAxes[0].xyzw);
+    gl_ClipDistance[1] = dot(dataPosition, vec4(-sceneDataAxes[0].xyz, sceneDataAxesExtents.x));
+    // -- Y axis
+    gl_ClipDistance[2] = dot(dataPosition, sceneDataAxes[1].xyzw);
+    gl_ClipDistance[3] = dot(dataPosition, vec4(-sceneDataAxes[1].xyz, sceneDataAxesExtents.y));
+    // -- Z axis
+    gl_ClipDistance[4] = dot(dataPosition, sceneDataAxes[2].xyzw);
+    gl_ClipDistance[5] = dot(dataPosition, vec4(-sceneDataAxes[2].xyz, sceneDataAxesExtents.z));
+#else
+    // Unclip vertices
+    // -- X axis
+    gl_ClipDistance[0] = 1.0;
+    gl_ClipDistance[1] = 1.0;
+    // -- Y axis
+    gl_ClipDistance[2] = 1.0;
+    gl_ClipDistance[3] = 1.0;
+    // -- Z axis
+    gl_ClipDistance[4] = 1.0;
+    gl_ClipDistance[5] = 1.0;
+#endif
+
+    // Output corner position and fragment data
+    gl_Position = p + vec4(offset.xy * quadCorner.y * p.w, 0.0, 0.0);
+    frag.position = vec3(gl_Position);
+    frag.normal = vec3(0.0);
+    frag.color = atEnd ? segmentEndColor : segmentStartColor;
+}
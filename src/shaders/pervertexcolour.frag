@@ -0,0 +1,11 @@
+#version 150 core
+
+// Input variables
+in vec4 flatColor;
+
+// Output variables
+out vec4 fragColour;
+
+void main() {
+  fragColour = vec4(flatColor.rgb, 1.0);
+}
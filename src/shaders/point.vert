@@ -0,0 +1,17 @@
+#version 150 core
+
+// Input variables
+in vec3 vertexPosition;
+
+// Standard uniform variables per-primitive
+uniform mat4 modelViewProjection;
+
+// Custom uniform variables
+uniform float pointSize;
+
+void main()
+{
+    // Output projected vertex position and point size - no lighting is performed, and clipping is handled by the scissor test
+    gl_Position = modelViewProjection * vec4(vertexPosition, 1.0);
+    gl_PointSize = pointSize;
+}
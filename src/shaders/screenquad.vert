@@ -0,0 +1,17 @@
+#version 150 core
+
+// Input variables
+in vec3 vertexPosition;
+
+// Output variables
+out vec2 texCoord;
+
+void main()
+{
+    // Vertices are given directly in normalised device coordinates - texture coordinates are flipped vertically since
+    // painted images are stored top row first
+    texCoord = vec2(vertexPosition.x + 1.0, 1.0 - vertexPosition.y) * 0.5;
+
+    // Output vertex position, ignoring all transforms
+    gl_Position = vec4(vertexPosition.xy, 0.0, 1.0);
+}
@@ -0,0 +1,14 @@
+#version 150 core
+
+// Input variables
+in vec2 texCoord;
+
+// Uniform variables per-primitive
+uniform sampler2D layerTexture;
+
+// Output variables
+out vec4 fragColour;
+
+void main() {
+  fragColour = texture(layerTexture, texCoord);
+}
@@ -1,6 +1,12 @@
 #include "widget.h"
 #include "material.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QHideEvent>
 #include <QResizeEvent>
+#include <QScopedValueRollback>
+#include <QShowEvent>
 #include <Qt3DInput/QKeyboardDevice>
 #include <Qt3DInput/QKeyboardHandler>
 #include <Qt3DInput/QMouseHandler>
@@ -20,11 +26,50 @@ void initialiseQtResources()
 using namespace Mildred;
 
 //! Constructs a Mildred widget which is a child of \param parent.
+/*!
+ * Only the data model (axes, data parent entities, and shader parameters) is created on construction, so that axes and data
+ * may be manipulated immediately. The Qt3D window, camera, framegraph, and view-only entities are created when the widget is
+ * first shown.
+ */
 MildredWidget::MildredWidget(QWidget *parent) : QWidget(parent)
 {
     // Initialise resources
     initialiseQtResources();
 
+    // Create our root entity
+    rootEntity_ = Qt3DCore::QEntityPtr(new Qt3DCore::QEntity);
+
+    // Set up our frame timer
+    frameTimer_.setSingleShot(true);
+    connect(&frameTimer_, SIGNAL(timeout()), this, SLOT(renderFrame()));
+
+    // Create parameters
+    sceneDataAxesParameter_ = new Qt3DRender::QParameter(QStringLiteral("sceneDataAxes"), QMatrix4x4());
+    sceneDataAxesExtentsParameter_ = new Qt3DRender::QParameter(QStringLiteral("sceneDataAxesExtents"), QVector3D());
+    sceneDataTransformInverseParameter_ = new Qt3DRender::QParameter(QStringLiteral("sceneDataTransformInverse"), QMatrix4x4());
+    viewportSizeParameter_ = new Qt3DRender::QParameter(QStringLiteral("viewportSize"), QVector2D());
+
+    // Set up basic scenegraph
+    createSceneGraph();
+
+    // Connect the metrics object and update
+    connect(&metrics_, SIGNAL(metricsChanged()), this, SLOT(updateTransforms()));
+}
+
+/*
+ * Qt3D Objects
+ */
+
+//! Create the Qt3D window, framegraph and view-only entities, if not already done
+/*!
+ * Creating the Qt3D window (and its aspect engine), camera, and framegraph is comparatively expensive, and so is deferred until
+ * the widget is first shown.
+ */
+void MildredWidget::initialiseView()
+{
+    if (viewWindow_)
+        return;
+
     /*
      * In order to get a suitable surface to draw on we must first create a full Qt3DWindow and then capture it in
      * a container widget.
@@ -33,19 +78,11 @@ MildredWidget::MildredWidget(QWidget *parent) : QWidget(parent)
 
     // Create a container for the Qt3DWindow
     viewContainer_ = createWindowContainer(viewWindow_, this);
+    viewContainer_->show();
 
-    // Create our root entity
-    rootEntity_ = Qt3DCore::QEntityPtr(new Qt3DCore::QEntity);
-
-    // Grab the QRenderSettings from the window
+    // Grab the QRenderSettings from the window, and only render frames when something has changed
     renderSettings_ = viewWindow_->renderSettings();
-
-    // Create parameters
-    sceneDataAxesParameter_ = new Qt3DRender::QParameter(QStringLiteral("sceneDataAxes"), QMatrix4x4());
-    sceneDataAxesExtentsParameter_ = new Qt3DRender::QParameter(QStringLiteral("sceneDataAxesExtents"), QVector3D());
-    sceneDataAxesOriginParameter_ = new Qt3DRender::QParameter(QStringLiteral("sceneDataAxesOrigin"), QVector3D());
-    sceneDataTransformInverseParameter_ = new Qt3DRender::QParameter(QStringLiteral("sceneDataTransformInverse"), QMatrix4x4());
-    viewportSizeParameter_ = new Qt3DRender::QParameter(QStringLiteral("viewportSize"), QVector2D());
+    renderSettings_->setRenderPolicy(Qt3DRender::QRenderSettings::OnDemand);
 
     // Add a mouse handler and connect it up
     auto *mouseHandler = new Qt3DInput::QMouseHandler(rootEntity_.data());
@@ -62,21 +99,66 @@ MildredWidget::MildredWidget(QWidget *parent) : QWidget(parent)
     // Construct a camera
     camera_ = new Qt3DRender::QCamera(rootEntity_.data());
     //    camera_->lens()->setPerspectiveProjection(45.0f, 16.0f/9.0f, 0.1f, 1000.0f);
-    camera_->lens()->setOrthographicProjection(0, width(), 0, height(), 0.1f, 1000.0f);
     camera_->setPosition(QVector3D(0, 0, 1.0f));
     camera_->setViewCenter(QVector3D(0, 0, -10.0));
 
-    // Create the framegraph
-    frameGraph_.create(renderSettings_, viewWindow_, camera_);
+    // Create the framegraph - it remains disabled until the widget can be seen
+    frameGraph_.create(renderSettings_, viewWindow_, camera_, frameGraphLayers());
+    frameGraph_.setFlat(flatView_);
+    frameGraph_.setEnabled(false);
 
-    // Set up basic scenegraph
-    createSceneGraph();
+    // Add entities which are only required for display
+    createViewEntities();
 
     // Set the main root entity
     viewWindow_->setRootEntity(rootEntity_.data());
 
-    // Connect the metrics object and update
-    connect(&metrics_, SIGNAL(metricsChanged()), this, SLOT(updateTransforms()));
+    // Match the view to our current size
+    updateViewGeometry();
+
+    // Monitor exposure of the view window so that rendering is suspended while it is obscured
+    viewWindow_->installEventFilter(this);
+}
+
+//! Return ratio of render target pixels to logical pixels
+double MildredWidget::renderPixelRatio() const { return offscreen_ ? offscreenPixelRatio_ : devicePixelRatioF(); }
+
+//! Update the camera and view objects for the current widget size
+void MildredWidget::updateViewGeometry()
+{
+    if (!camera_)
+        return;
+
+    // Reset projection for new viewport
+    camera_->lens()->setOrthographicProjection(0, width(), 0, height(), 0.1f, width() * 2.0f);
+    camera_->setAspectRatio(float(width()) / float(height()));
+
+    // Debug objects
+    sceneBoundingCuboidTransform_->setScale3D(QVector3D(width(), height(), width()));
+
+    // Match the axes cache to the window (offscreen targets are sized explicitly when an image is requested)
+    if (!offscreen_)
+        axesCacheEntity_->setSize(size() * devicePixelRatioF());
+
+    // Resize our view container
+    if (viewContainer_)
+        viewContainer_->resize(this->size());
+}
+
+//! Update scene, view, and metrics for the current widget size
+void MildredWidget::updateForSize()
+{
+    // Move the scene root position to be the centre of the XY plane and a suitable distance away
+    sceneRootTransform_->setTranslation(QVector3D(width() / 2.0, height() / 2.0, -width()));
+
+    // Update camera and view container, if they exist
+    updateViewGeometry();
+
+    // Update metrics, parameters, and transforms in the next frame
+    invalidate(Invalidation::Metrics | Invalidation::Camera);
+
+    // Lastly, suspend or resume rendering if we have collapsed to / expanded from zero size
+    updateViewActivity();
 }
 
 /*
@@ -88,26 +170,204 @@ MildredWidget::MildredWidget(QWidget *parent) : QWidget(parent)
  * Resizing the widget demands that the metrics information held in @class MildredMetrics is updated, ensuring the whole of the
  * available drawing surface is used for visualisation.
  */
-void MildredWidget::resizeEvent(QResizeEvent *event)
+void MildredWidget::resizeEvent(QResizeEvent *event) { updateForSize(); }
+
+//! Handle QWidget show events
+void MildredWidget::showEvent(QShowEvent *event)
 {
-    updateMetrics();
+    // Create the view proper if this is the first time we have been shown (unless we render offscreen)
+    if (!offscreen_)
+        initialiseView();
 
-    // Move the scene root position to be the centre of the XY plane and a suitable distance away
-    sceneRootTransform_->setTranslation(QVector3D(width() / 2.0, height() / 2.0, -width()));
+    // Monitor our top-level window so we know when it is minimised
+    if (monitoredWindow_ != window())
+    {
+        if (monitoredWindow_)
+            monitoredWindow_->removeEventFilter(this);
+        monitoredWindow_ = window();
+        monitoredWindow_->installEventFilter(this);
+    }
 
-    // Reset projection for new viewport
-    camera_->lens()->setOrthographicProjection(0, width(), 0, height(), 0.1f, width() * 2.0f);
-    camera_->setAspectRatio(float(width()) / float(height()));
+    updateViewActivity();
+}
 
-    // Debug objects
-    sceneBoundingCuboidTransform_->setScale3D(QVector3D(width(), height(), width()));
+//! Handle QWidget hide events
+void MildredWidget::hideEvent(QHideEvent *event) { updateViewActivity(); }
+
+//! Filter events for the top-level window and view window
+/*!
+ * Window state changes of the top-level window (e.g. minimisation) and exposure changes of the Qt3D view window are monitored
+ * in order to suspend and resume rendering. Events are never consumed.
+ */
+bool MildredWidget::eventFilter(QObject *watched, QEvent *event)
+{
+    if ((watched == monitoredWindow_ && event->type() == QEvent::WindowStateChange) ||
+        (watched == viewWindow_ && event->type() == QEvent::Expose))
+        updateViewActivity();
+
+    return QWidget::eventFilter(watched, event);
+}
+
+/*
+ * Visibility
+ */
+
+//! Update view activity following a change in visibility, size, or window state
+/*!
+ * The view is active only when it can actually be seen - i.e. the widget is visible, has a non-zero size, its top-level window
+ * is not minimised, and the view window is exposed. Offscreen views are always active. While inactive the framegraph is
+ * disabled so the renderer issues no draw calls, invalidations are accumulated without scheduling frames, and recreation of
+ * data renderables is suspended. When the view becomes active again all accumulated work is applied in a single pass, with each
+ * data entity recreated at most once.
+ */
+void MildredWidget::updateViewActivity()
+{
+    auto active = offscreen_ || (viewWindow_ && isVisible() && width() > 0 && height() > 0 && !window()->isMinimized() &&
+                                 (isRasterActive() || viewWindow_->isExposed()));
+    if (active == viewActive_)
+        return;
+
+    viewActive_ = active;
+
+    frameGraph_.setEnabled(viewActive_ && !isRasterActive());
+    renderSettings_->setRenderPolicy(viewActive_ && !renderOnDemand_ ? Qt3DRender::QRenderSettings::Always
+                                                                     : Qt3DRender::QRenderSettings::OnDemand);
+
+    if (viewActive_)
+    {
+        // Apply pending invalidations while data recreation is still suspended, then recreate each data entity once
+        renderFrame();
+        for (auto &[tag, entity] : dataEntities_)
+            entity->setRenderablesSuspended(isRasterActive());
+    }
+    else
+    {
+        frameTimer_.stop();
+        for (auto &[tag, entity] : dataEntities_)
+            entity->setRenderablesSuspended(true);
+    }
+}
+
+//! Return whether the view can currently be seen, and is therefore being rendered
+bool MildredWidget::isViewActive() const { return viewActive_; }
+
+/*
+ * Rendering Control
+ */
+
+//! Process pending invalidations and produce a frame
+/*!
+ * Perform all work required by the invalidations accumulated since the last frame - recalculating metrics, transforms and
+ * shader parameters as necessary - in a single pass. Since the Qt3D renderer operates on demand, this is the only point at
+ * which the widget causes a new frame to be drawn.
+ */
+void MildredWidget::renderFrame()
+{
+    auto invalidations = pendingInvalidations_;
+    pendingInvalidations_ = {};
+    if (!invalidations)
+        return;
+
+    // Changes made while applying the invalidations (e.g. data recreated following a change in metrics) are part of this frame
+    QScopedValueRollback<bool> applyingFrame(applyingFrame_, true);
+
+    // Apply accumulated mouse input, which may itself invalidate the axes or camera
+    if (invalidations.testFlag(Invalidation::Input))
+        invalidations |= applyPendingInput();
+
+    // Recalculating the metrics will, in turn, recreate axes and data and update transforms
+    if (invalidations.testFlag(Invalidation::Metrics))
+        metrics_.update(width(), height(), xAxis_, yAxis_);
+    else if (invalidations.testFlag(Invalidation::Axes))
+    {
+        updateTransforms();
+
+        // Windowed data show only the visible part of the data, so must follow changes in the axis limits
+        for (auto &[tag, entity] : dataEntities_)
+            if (auto *data1D = dynamic_cast<Data1DEntity *>(entity); data1D && data1D->isWindowed())
+                data1D->updateRenderables();
+    }
+
+    if (invalidations & (Invalidation::Metrics | Invalidation::Axes | Invalidation::Camera))
+        updateShaderParameters();
+
+    // Repaint the axes cache if the axes were recreated
+    if (axesCacheDirty_ && axesCacheEntity_ && flatView_ && !isRasterActive())
+    {
+        axesCacheEntity_->repaint();
+        axesCacheDirty_ = false;
+    }
+
+    if (isRasterActive())
+    {
+        rasterImageDirty_ = true;
+        update();
+    }
+
+    ++renderStatistics_.framesRendered;
+    lastFrameTimer_.start();
+}
+
+//! Set maximum frame rate
+/*!
+ * Set the maximum rate, in frames per second, at which the display will be updated in response to invalidations (e.g. during
+ * interaction with the mouse). Invalidations arriving faster than this are merged into the next frame.
+ */
+void MildredWidget::setMaximumFrameRate(int fps) { maximumFrameRate_ = std::max(1, fps); }
+
+//! Return maximum frame rate
+int MildredWidget::maximumFrameRate() const { return maximumFrameRate_; }
+
+//! Set whether frames are only rendered on demand
+/*!
+ * If @param onDemand is true (the default) the Qt3D renderer only draws a frame when the scene has changed, leaving the
+ * render loop idle otherwise. If false, frames are rendered continuously while the view can be seen.
+ */
+void MildredWidget::setRenderOnDemand(bool onDemand)
+{
+    renderOnDemand_ = onDemand;
+    if (renderSettings_)
+        renderSettings_->setRenderPolicy(viewActive_ && !renderOnDemand_ ? Qt3DRender::QRenderSettings::Always
+                                                                     : Qt3DRender::QRenderSettings::OnDemand);
+}
 
-    // Update parameters and transforms
-    updateTransforms();
-    updateShaderParameters();
+//! Return whether frames are only rendered on demand
+bool MildredWidget::isRenderOnDemand() const { return renderOnDemand_; }
 
-    // Lastly, resize our view container
-    viewContainer_->resize(this->size());
+//! Return render statistics
+const MildredWidget::RenderStatistics &MildredWidget::renderStatistics() const { return renderStatistics_; }
+
+//! Reset render statistics
+void MildredWidget::resetRenderStatistics() { renderStatistics_ = RenderStatistics(); }
+
+//! Mark the display as requiring a new frame
+/*!
+ * Register the supplied @param invalidations and schedule a new frame, subject to the maximum frame rate. If a frame is
+ * already pending the invalidations are merged into it and the request is counted as skipped. If the view cannot currently be
+ * seen the invalidations are retained until it can, and no frame is scheduled. Invalidations raised while a frame is being
+ * applied are already covered by that frame, and are ignored.
+ */
+void MildredWidget::invalidate(Invalidations invalidations)
+{
+    if (applyingFrame_)
+        return;
+
+    if (!viewActive_)
+    {
+        ++renderStatistics_.framesDeferred;
+        pendingInvalidations_ |= invalidations;
+        return;
+    }
+
+    if (pendingInvalidations_)
+        ++renderStatistics_.framesSkipped;
+    pendingInvalidations_ |= invalidations;
+
+    if (frameTimer_.isActive())
+        return;
+
+    auto frameInterval = 1000 / maximumFrameRate_;
+    frameTimer_.start(lastFrameTimer_.isValid() ? std::max(0, int(frameInterval - lastFrameTimer_.elapsed())) : 0);
 }
 
 /*
@@ -116,9 +376,9 @@ void MildredWidget::resizeEvent(QResizeEvent *event)
 
 //! Update metrics for current surface size
 /*!
- *  Updates the internal @class MildredMetrics object.
+ * Flags the internal @class MildredMetrics object for update in the next frame.
  */
-void MildredWidget::updateMetrics() { metrics_.update(width(), height(), xAxis_, yAxis_); }
+void MildredWidget::updateMetrics() { invalidate(Invalidation::Metrics); }
 
 /*
  * Appearance
@@ -132,6 +392,9 @@ bool MildredWidget::isFlatView() const { return flatView_; }
  * This controls whether the current view is set to fixed, flat (2D) drawing (@param flat = true) with only the x and y axes
  * shown, or the view is full 3D in which case all axes (including the depth z axis) are visible.
  *
+ * Flat views are drawn with a lightweight pipeline which clips data with a scissor rectangle rather than clip planes, and
+ * which uses unlit shaders with neither depth testing nor a geometry stage.
+ *
  * Changing the view type necessarily enforces a recalculation of the metrics object.
  */
 void MildredWidget::setFlatView(bool flat)
@@ -141,35 +404,221 @@ void MildredWidget::setFlatView(bool flat)
 
     flatView_ = flat;
 
-    // Set z-axis visibility
-    zAxis_->setEnabled(!flatView_);
+    // Set z-axis visibility, creating it if necessary
+    if (!flatView_ && !zAxis_)
+        createZAxis();
+    if (zAxis_)
+        zAxis_->setEnabled(!flatView_);
+
+    // Axes in flat views are painted into the axes cache, so need no renderable geometry
+    for (auto *axis : {xAxis_, yAxis_})
+        if (axis)
+            axis->setGeometryEnabled(!flatView_);
+
+    // Switch pipeline and data shaders - flat views use the lightweight 2D pipeline
+    if (camera_)
+        frameGraph_.setFlat(flatView_);
+    auto shaders = dataShaders();
+    for (auto &[tag, entity] : dataEntities_)
+        if (auto *material = dynamic_cast<RenderableMaterial *>(entity->dataMaterial()); material)
+            material->setShaders(effect(shaders), shaders);
+
+    // Selections are only shown in flat views
+    for (auto &[tag, entity] : dataEntities_)
+        if (auto *data1D = dynamic_cast<Data1DEntity *>(entity); data1D)
+            data1D->setSelectionVisible(flatView_);
 
     // Reset view and update
     resetView();
-    updateMetrics();
+    invalidate(Invalidation::Metrics);
+
+    // The raster backend only handles flat views
+    if (renderBackend_ == RenderBackend::Raster)
+        updateRenderBackend();
+}
+
+//! Set line render mode
+/*!
+ * Set the method used to draw wide lines (axes, and data in 3D views). Lines may be tesselated into quads by a geometry shader
+ * (the default) or drawn as one instanced quad per segment, which avoids the geometry stage entirely and is often faster on
+ * software rasterisers and some drivers. All existing line materials are switched to the new method, and materials created
+ * subsequently will use it.
+ */
+void MildredWidget::setLineRenderMode(LineRenderMode mode)
+{
+    if (lineRenderMode_ == mode)
+        return;
+
+    lineRenderMode_ = mode;
+
+    // Update axis bar materials
+    for (auto *axis : {xAxis_, yAxis_, zAxis_})
+        if (axis)
+        {
+            auto shaders = lineShaders(axis->axisBarMaterial()->shaders());
+            axis->axisBarMaterial()->setShaders(effect(shaders), shaders);
+        }
+
+    // Update data materials
+    auto shaders = dataShaders();
+    for (auto &[tag, entity] : dataEntities_)
+        if (auto *material = dynamic_cast<RenderableMaterial *>(entity->dataMaterial()); material)
+            material->setShaders(effect(shaders), shaders);
+
+    // Line geometry must be regenerated for the new method, which happens when axes and data are recreated
+    invalidate(Invalidation::Metrics);
+}
+
+//! Return line render mode
+MildredWidget::LineRenderMode MildredWidget::lineRenderMode() const { return lineRenderMode_; }
+
+/*
+ * FrameGraph
+ */
+
+//! Request capture of the next rendered frame
+/*!
+ * Request that the next frame rendered by the display is captured, returning the associated reply. The reply's completed()
+ * signal is emitted once the frame has been rendered, and the caller takes ownership of the reply. The view is only created
+ * when the widget is first shown, so nullptr is returned if the widget has never been shown.
+ */
+Qt3DRender::QRenderCaptureReply *MildredWidget::captureFrame()
+{
+    if (!frameGraph_.renderCapture())
+        return nullptr;
+
+    return frameGraph_.renderCapture()->requestCapture();
+}
+
+/*
+ * Program Cache
+ */
+
+//! Enable the persistent on-disk shader program binary cache
+/*!
+ * Enable caching of linked shader program binaries on disk, such that shader compilation is avoided on subsequent launches.
+ * Qt3D compiles all programs through the cacheable QOpenGLShaderProgram path, so cached binaries are keyed on a hash of the
+ * shader sources along with the GL vendor, renderer, and version strings, and are invalidated automatically if any change.
+ *
+ * This is an application-level setting rather than a property of any widget, and must be called before the QApplication is
+ * constructed. Qt enables the cache by default, so this function only has an effect if the cache has been disabled (through
+ * Qt::AA_DisableShaderDiskCache or the QT_DISABLE_SHADER_DISK_CACHE environment variable), which it reverses for the whole
+ * process.
+ *
+ * If @param cacheDirectory is specified, cached binaries are stored there rather than in the standard user cache location.
+ * This is achieved by setting the XDG_CACHE_HOME environment variable (on platforms where it is respected), which affects the
+ * cache location of everything else in the process using it.
+ */
+void MildredWidget::enableProgramBinaryCache(const QString &cacheDirectory)
+{
+    if (QCoreApplication::instance())
+        printf("Warning: Program binary cache should be enabled before the application is created.\n");
+
+    QCoreApplication::setAttribute(Qt::AA_DisableShaderDiskCache, false);
+    qunsetenv("QT_DISABLE_SHADER_DISK_CACHE");
+
+    if (!cacheDirectory.isEmpty())
+    {
+        QDir().mkpath(cacheDirectory);
+        qputenv("XDG_CACHE_HOME", QFile::encodeName(QDir(cacheDirectory).absolutePath()));
+    }
+}
+
+//! Return whether the persistent on-disk shader program binary cache is enabled
+bool MildredWidget::isProgramBinaryCacheEnabled()
+{
+    return !QCoreApplication::testAttribute(Qt::AA_DisableShaderDiskCache) &&
+           qEnvironmentVariableIsEmpty("QT_DISABLE_SHADER_DISK_CACHE");
 }
 
 /*
  * Display Data
  */
 
+//! Return effect for the specified shader combination, creating it if necessary
+/*!
+ * Return the QEffect implementing the specified @param shaders. Effects are created once per shader combination and shared
+ * between all materials using that combination, so the number of shader programs scales with the number of shader variants in
+ * use rather than the number of displayed entities. Scene-wide shader parameters are attached to the effect when it is first
+ * created.
+ */
+Qt3DRender::QEffect *MildredWidget::effect(RenderableMaterial::ShaderCombination shaders)
+{
+    auto it = effects_.find(shaders);
+    if (it != effects_.end())
+        return it->second;
+
+    auto &&[vertexShader, geometryShader, fragmentShader] = shaders;
+    auto *newEffect = RenderableMaterial::createEffect(rootEntity_.data(), vertexShader, geometryShader, fragmentShader);
+
+    // Attach necessary parameters
+    newEffect->addParameter(sceneDataAxesParameter_);
+    newEffect->addParameter(sceneDataAxesExtentsParameter_);
+    newEffect->addParameter(sceneDataTransformInverseParameter_);
+    newEffect->addParameter(viewportSizeParameter_);
+
+    effects_.emplace(shaders, newEffect);
+
+    return newEffect;
+}
+
+//! Return shader combination to use for data in the current view
+/*!
+ * Data in flat views is drawn with unlit per-vertex colour and no clip distances or geometry stage, since clipping is performed
+ * by the scissor test in the flat framegraph branch. Wide lines are always drawn as instanced quads in flat views, regardless
+ * of the line render mode. In 3D views data is clipped to the data volume in the vertex shader and lit.
+ */
+RenderableMaterial::ShaderCombination MildredWidget::dataShaders() const
+{
+    if (flatView_)
+        return {RenderableMaterial::VertexShaderType::Flat, RenderableMaterial::GeometryShaderType::None,
+                RenderableMaterial::FragmentShaderType::PerVertexColour};
+
+    return lineShaders({RenderableMaterial::VertexShaderType::ClippedToDataVolume,
+                        RenderableMaterial::GeometryShaderType::LineTesselator,
+                        RenderableMaterial::FragmentShaderType::PerVertexPhong});
+}
+
+//! Return the supplied shader combination adjusted for the current line render mode
+/*!
+ * Wide lines are drawn either by tesselating each segment in a geometry shader, or by drawing each segment as an instanced
+ * quad. Convert the supplied @param shaders between the two forms as required by the current line render mode, leaving
+ * combinations which do not draw wide lines unchanged.
+ */
+RenderableMaterial::ShaderCombination MildredWidget::lineShaders(RenderableMaterial::ShaderCombination shaders) const
+{
+    auto &&[vertexShader, geometryShader, fragmentShader] = shaders;
+
+    if (lineRenderMode_ == LineRenderMode::InstancedQuads &&
+        geometryShader == RenderableMaterial::GeometryShaderType::LineTesselator)
+        return {vertexShader == RenderableMaterial::VertexShaderType::ClippedToDataVolume
+                    ? RenderableMaterial::VertexShaderType::ClippedInstancedLine
+                    : RenderableMaterial::VertexShaderType::InstancedLine,
+                RenderableMaterial::GeometryShaderType::None, fragmentShader};
+
+    if (lineRenderMode_ == LineRenderMode::GeometryShader &&
+        (vertexShader == RenderableMaterial::VertexShaderType::InstancedLine ||
+         vertexShader == RenderableMaterial::VertexShaderType::ClippedInstancedLine))
+        return {vertexShader == RenderableMaterial::VertexShaderType::ClippedInstancedLine
+                    ? RenderableMaterial::VertexShaderType::ClippedToDataVolume
+                    : RenderableMaterial::VertexShaderType::Unclipped,
+                RenderableMaterial::GeometryShaderType::LineTesselator, fragmentShader};
+
+    return shaders;
+}
+
 //! Create material for specified entity
 /*!
  * Create and attach a new RenderableMaterial to the specified @param parent, with the specified @param vertexShader, @param
- * geometryShader, and @param fragmentShader.
+ * geometryShader, and @param fragmentShader. The underlying effect is shared with all other materials using the same shader
+ * combination. Combinations drawing wide lines are adjusted to suit the current line render mode.
  */
 RenderableMaterial *MildredWidget::createMaterial(Qt3DCore::QEntity *parent, RenderableMaterial::VertexShaderType vertexShader,
                                                   RenderableMaterial::GeometryShaderType geometryShader,
                                                   RenderableMaterial::FragmentShaderType fragmentShader)
 {
-    auto *material = new RenderableMaterial(parent, vertexShader, geometryShader, fragmentShader);
-
-    // Attach necessary parameters
-    material->addParameter(sceneDataAxesParameter_);
-    material->addParameter(sceneDataAxesExtentsParameter_);
-    material->addParameter(sceneDataAxesOriginParameter_);
-    material->addParameter(sceneDataTransformInverseParameter_);
-    material->addParameter(viewportSizeParameter_);
+    auto shaders = lineShaders({vertexShader, geometryShader, fragmentShader});
+    auto *material = new RenderableMaterial(parent, effect(shaders), shaders);
 
     // Add the material as a component on the parent
     parent->addComponent(material);
@@ -191,16 +640,28 @@ Data1DEntity *MildredWidget::addData1D(std::string_view tag)
     // Create a new entity
     auto *entity = new Data1DEntity(xAxis_, yAxis_, dataEntityParent_);
     connect(&metrics_, SIGNAL(metricsChanged()), entity, SLOT(updateRenderables()));
+    connect(entity, &DataEntity::renderablesInvalidated, this, [this]() { invalidate(Invalidation::Data); });
+    entity->setRenderablesSuspended(!viewActive_ || isRasterActive());
     dataEntities_.emplace_back(tag, entity);
 
-    // Add a material
-    auto *material = createMaterial(entity, RenderableMaterial::VertexShaderType::ClippedToDataVolume,
-                                    RenderableMaterial::GeometryShaderType::LineTesselator,
-                                    RenderableMaterial::FragmentShaderType::PerVertexPhong);
+    // Add a material, with its effect appropriate to the current view
+    auto shaders = dataShaders();
+    auto *material = new RenderableMaterial(entity, effect(shaders), shaders);
+    entity->addComponent(material);
     entity->setDataMaterial(material);
     entity->setErrorMaterial(material);
     entity->setSymbolMaterial(material);
 
+    // Add a material for highlighting selected points
+    RenderableMaterial::ShaderCombination selectionShaders{RenderableMaterial::VertexShaderType::Point,
+                                                           RenderableMaterial::GeometryShaderType::None,
+                                                           RenderableMaterial::FragmentShaderType::Monochrome};
+    auto *selectionMaterial = new RenderableMaterial(entity, effect(selectionShaders), selectionShaders);
+    selectionMaterial->setAmbient(selectionColour_);
+    selectionMaterial->addParameter(new Qt3DRender::QParameter(QStringLiteral("pointSize"), selectionPointSize_));
+    entity->setSelectionMaterial(selectionMaterial);
+    entity->setSelectionVisible(flatView_);
+
     return entity;
 }
 
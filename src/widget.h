@@ -4,18 +4,29 @@
 #include "displaygroup.h"
 #include "entities/axis.h"
 #include "entities/data1d.h"
+#include "entities/glyphtext.h"
+#include "entities/layercache.h"
 #include "framegraph.h"
 #include "material.h"
+#include <QElapsedTimer>
+#include <QImage>
+#include <QOffscreenSurface>
+#include <QPainter>
+#include <QPointer>
 #include <QResizeEvent>
 #include <QScopedPointer>
 #include <QTimer>
 #include <QWidget>
+#include <Qt3DCore/QAspectEngine>
 #include <Qt3DCore/QEntityPtr>
 #include <Qt3DExtras/Qt3DWindow>
 #include <Qt3DInput/QKeyEvent>
 #include <Qt3DInput/QMouseEvent>
 #include <Qt3DRender/QCamera>
 #include <Qt3DRender/QRenderSettings>
+#include <limits>
+#include <map>
+#include <optional>
 
 namespace Mildred
 {
@@ -60,6 +71,21 @@ class MildredWidget : public QWidget
     Qt3DRender::QCamera *camera_{nullptr};
     // Rendering framegraph
     MildredFrameGraph frameGraph_;
+    // Offscreen surface and aspect engine (offscreen rendering only)
+    QScopedPointer<QOffscreenSurface> offscreenSurface_;
+    QScopedPointer<Qt3DCore::QAspectEngine> offscreenEngine_;
+    // Ratio of render target pixels to logical pixels (offscreen rendering only)
+    double offscreenPixelRatio_{1.0};
+
+    private:
+    // Create the Qt3D window, framegraph and view-only entities, if not already done
+    void initialiseView();
+    // Return ratio of render target pixels to logical pixels
+    double renderPixelRatio() const;
+    // Update the camera and view objects for the current widget size
+    void updateViewGeometry();
+    // Update scene, view, and metrics for the current widget size
+    void updateForSize();
 
     /*
      * QWidget
@@ -67,6 +93,102 @@ class MildredWidget : public QWidget
     protected:
     // Widget resized
     void resizeEvent(QResizeEvent *event) override;
+    // Widget shown
+    void showEvent(QShowEvent *event) override;
+    // Widget hidden
+    void hideEvent(QHideEvent *event) override;
+    // Filter events for the top-level window and view window
+    bool eventFilter(QObject *watched, QEvent *event) override;
+    // Paint widget (raster backend only)
+    void paintEvent(QPaintEvent *event) override;
+
+    /*
+     * Visibility
+     */
+    private:
+    // Whether the view can currently be seen, and is therefore being rendered
+    bool viewActive_{false};
+    // Top-level window monitored for state changes
+    QPointer<QWidget> monitoredWindow_;
+
+    private:
+    // Update view activity following a change in visibility, size, or window state
+    void updateViewActivity();
+
+    public:
+    // Return whether the view can currently be seen, and is therefore being rendered
+    bool isViewActive() const;
+
+    /*
+     * Rendering Control
+     */
+    public:
+    // Invalidation types
+    enum class Invalidation
+    {
+        Data = 0x1,
+        Axes = 0x2,
+        Metrics = 0x4,
+        Camera = 0x8,
+        Material = 0x10,
+        Input = 0x20
+    };
+    Q_DECLARE_FLAGS(Invalidations, Invalidation)
+    // Render statistics
+    struct RenderStatistics
+    {
+        // Number of frames produced
+        int framesRendered{0};
+        // Number of frame requests merged into an already-pending frame
+        int framesSkipped{0};
+        // Number of frame requests deferred while the view could not be seen
+        int framesDeferred{0};
+        // Number of input events received, and number of times accumulated input was applied
+        int inputEventsReceived{0}, inputUpdatesApplied{0};
+        // Return average number of input events applied per update
+        double inputCoalescingRatio() const
+        {
+            return inputUpdatesApplied > 0 ? double(inputEventsReceived) / inputUpdatesApplied : 0.0;
+        }
+    };
+
+    private:
+    // Invalidations waiting to be processed by the next frame
+    Invalidations pendingInvalidations_;
+    // Whether pending invalidations are currently being applied
+    bool applyingFrame_{false};
+    // Timer used to schedule the next frame
+    QTimer frameTimer_;
+    // Time since the last frame was produced
+    QElapsedTimer lastFrameTimer_;
+    // Maximum frame rate
+    int maximumFrameRate_{60};
+    // Whether frames are only rendered on demand
+    bool renderOnDemand_{true};
+    // Render statistics
+    RenderStatistics renderStatistics_;
+
+    private slots:
+    // Process pending invalidations and produce a frame
+    void renderFrame();
+
+    public:
+    // Set maximum frame rate
+    void setMaximumFrameRate(int fps);
+    // Return maximum frame rate
+    int maximumFrameRate() const;
+    // Set whether frames are only rendered on demand
+    void setRenderOnDemand(bool onDemand);
+    // Return whether frames are only rendered on demand
+    bool isRenderOnDemand() const;
+    // Return render statistics
+    const RenderStatistics &renderStatistics() const;
+    // Reset render statistics
+    void resetRenderStatistics();
+
+    public slots:
+    // Mark the display as requiring a new frame
+    void invalidate(Invalidations invalidations);
 
     /*
      * Metrics
@@ -82,13 +204,27 @@ class MildredWidget : public QWidget
     /*
      * Appearance
      */
+    public:
+    // Line render modes
+    enum class LineRenderMode
+    {
+        GeometryShader,
+        InstancedQuads
+    };
+
     private:
     // Whether the current view is flat
     bool flatView_{true};
+    // Method used to draw wide lines
+    LineRenderMode lineRenderMode_{LineRenderMode::GeometryShader};
 
     public:
     // Return whether the view is flat
     bool isFlatView() const;
+    // Set line render mode
+    void setLineRenderMode(LineRenderMode mode);
+    // Return line render mode
+    LineRenderMode lineRenderMode() const;
 
     public slots:
     // Set whether view is flat
@@ -100,6 +236,82 @@ class MildredWidget : public QWidget
     private:
     MildredFrameGraph framegraph_;
 
+    public:
+    // Request capture of the next rendered frame (or return nullptr if the widget has never been shown)
+    Qt3DRender::QRenderCaptureReply *captureFrame();
+
+    /*
+     * Render Backend
+     */
+    public:
+    // Available render backends
+    enum class RenderBackend
+    {
+        Qt3D,
+        Raster
+    };
+
+    private:
+    // Requested render backend
+    RenderBackend renderBackend_{RenderBackend::Qt3D};
+    // Raster image of the current scene, and whether it needs to be redrawn
+    QImage rasterImage_;
+    bool rasterImageDirty_{true};
+
+    private:
+    // Return whether the raster backend is in use for the current view
+    bool isRasterActive() const;
+    // Update view state following a change in the active backend
+    void updateRenderBackend();
+    // Map scaled display volume coordinates to raster coordinates
+    QPointF toRaster(QVector3D v) const;
+    // Paint the current flat view with the supplied painter, in widget coordinates
+    void paintRaster(QPainter &painter) const;
+    // Paint the enabled x and y axes
+    void paintRasterAxes(QPainter &painter) const;
+    // Paint the specified axis
+    void paintRasterAxis(QPainter &painter, const AxisEntity *axis) const;
+    // Paint the specified data entity
+    void paintRasterData(QPainter &painter, const Data1DEntity *entity) const;
+
+    public:
+    // Set render backend
+    void setRenderBackend(RenderBackend backend);
+    // Return render backend
+    RenderBackend renderBackend() const;
+    // Render the current scene with the raster backend to an image of the specified size and resolution
+    QImage renderRasterImage(QSize size, double dpi = 96.0);
+
+    /*
+     * Offscreen Rendering
+     */
+    private:
+    // Whether the widget renders offscreen rather than to a window
+    bool offscreen_{false};
+
+    private:
+    // Create the offscreen aspect engine, framegraph and view-only entities, if not already done
+    void initialiseOffscreenView();
+    // Bring the scene up to date for rendering an image of the specified size and resolution
+    void prepareImage(QSize size, double dpi);
+
+    public:
+    // Return whether the widget renders offscreen
+    bool isOffscreen() const;
+    // Request an offscreen render of the current scene at the specified size and resolution
+    Qt3DRender::QRenderCaptureReply *requestImage(QSize size, double dpi = 96.0);
+    // Render the current scene offscreen to an image of the specified size and resolution
+    QImage renderImage(QSize size, double dpi = 96.0);
+
+    /*
+     * Program Cache
+     */
+    public:
+    // Enable the persistent on-disk shader program binary cache (application-level, before QApplication is constructed)
+    static void enableProgramBinaryCache(const QString &cacheDirectory = {});
+    // Return whether the persistent on-disk shader program binary cache is enabled
+    static bool isProgramBinaryCacheEnabled();
+
     /*
      * SceneGraph
      */
@@ -110,25 +322,42 @@ class MildredWidget : public QWidget
     QQuaternion viewRotationMatrix_;
     // Head node for scene (owned by root entity)
     Qt3DCore::QEntity *sceneRootEntity_{nullptr};
+    // Parent entity for all viewable objects
+    Qt3DCore::QEntity *sceneObjectsEntity_{nullptr};
+    // Parent entity for axes
+    Qt3DCore::QEntity *axesEntity_{nullptr};
     // Axes
     AxisEntity *xAxis_{nullptr}, *yAxis_{nullptr}, *altYAxis_{nullptr}, *zAxis_{nullptr};
     // Transforms and associated parameters
     Qt3DCore::QTransform *dataOriginTransform_{nullptr}, *sceneObjectsTransform_{nullptr}, *sceneRootTransform_{nullptr};
     // Data Entities
     Qt3DCore::QEntity *dataRootEntity_{nullptr}, *dataEntityParent_{nullptr};
+    // Layers identifying data, axes, and axes cache entities within the framegraph
+    Qt3DRender::QLayer *dataLayer_{nullptr}, *axesLayer_{nullptr}, *axesCacheLayer_{nullptr};
+    // Pre-rendered axes for flat views, and whether it needs to be repainted
+    LayerCacheEntity *axesCacheEntity_{nullptr};
+    bool axesCacheDirty_{true};
     // Debug objects
     Qt3DCore::QEntity *sceneBoundingCuboidEntity_{nullptr};
     Qt3DCore::QTransform *sceneBoundingCuboidTransform_{nullptr};
+    bool sceneCuboidEnabled_{false};
     // Shader parameters
     Qt3DRender::QParameter *sceneDataAxesParameter_{nullptr};
     Qt3DRender::QParameter *sceneDataAxesExtentsParameter_{nullptr};
-    Qt3DRender::QParameter *sceneDataAxesOriginParameter_{nullptr};
     Qt3DRender::QParameter *sceneDataTransformInverseParameter_{nullptr};
     Qt3DRender::QParameter *viewportSizeParameter_{nullptr};
 
     private:
     // Create basic scenegraph
     void createSceneGraph();
+    // Create entities required only for display
+    void createViewEntities();
+    // Create the z axis
+    void createZAxis();
+    // Return scaled position of the data axes origin along the depth axis
+    QVector3D dataDepthOrigin() const;
+    // Return framegraph layers
+    MildredFrameGraph::Layers frameGraphLayers() const;
     // Convert widget position to 2D (flat) coordinates
     QPointF toAxes2D(QPoint pos) const;
     // Return screen coordinates at centre of 2D view
@@ -167,7 +396,32 @@ class MildredWidget : public QWidget
     // Mouse coordinate style
     CoordinateDisplayStyle mouseCoordStyle_{CoordinateDisplayStyle::FixedAnchor};
     // Mouse coordinate entity
-    TextEntity *mouseCoordEntity_{nullptr};
+    GlyphTextEntity *mouseCoordEntity_{nullptr};
+    // Whether the mouse crosshair is shown
+    bool crosshairEnabled_{false};
+    // Mouse crosshair entity
+    LineEntity *crosshairEntity_{nullptr};
+    // Input accumulated between frames
+    struct PendingInput
+    {
+        // Mouse deltas for rotation (3D) and translation (2D)
+        QPoint rotation, translation;
+        // Net number of zoom steps, and position at which to zoom
+        int zoomSteps{0};
+        QPoint zoomPosition;
+        // Whether the selection region has changed
+        bool selectionRegionChanged{false};
+        // Latest cursor position
+        std::optional<QPoint> cursorPosition;
+    };
+    // Input accumulated since the last frame
+    PendingInput pendingInput_;
+
+    private:
+    // Update the mouse coordinate display for the specified widget position
+    void updateMouseCoordinates(QPoint pos);
+    // Apply input accumulated since the last frame
+    Invalidations applyPendingInput();
 
     private slots:
     void mousePositionChanged(Qt3DInput::QMouseEvent *event);
@@ -175,8 +429,25 @@ class MildredWidget : public QWidget
     void mouseButtonReleased(Qt3DInput::QMouseEvent *event);
     void mouseWheeled(Qt3DInput::QWheelEvent *event);
 
+    public:
+    // Data point located by a query
+    struct DataPoint
+    {
+        // Tag of the data entity containing the point
+        std::string tag;
+        // Index of the point within the entity's data
+        int index;
+        // Axis coordinates of the point
+        QPointF value;
+        // Distance (in pixels) from the query position
+        double distance;
+    };
+    // Return the data point nearest to the specified widget position
+    std::optional<DataPoint> nearestPoint(QPoint pos, double maximumDistance = std::numeric_limits<double>::infinity()) const;
+
     public slots:
     void setMouseCoordStyle(CoordinateDisplayStyle style);
+    void setCrosshairEnabled(bool enabled);
 
     signals:
     void mouseCoordChanged(QPointF pos);
@@ -195,7 +466,16 @@ class MildredWidget : public QWidget
     // Associated data entities (with identifying tag)
     std::vector<std::pair<std::string, DataEntity *>> dataEntities_;
 
+    // Effects shared between materials, keyed by shader combination
+    std::map<RenderableMaterial::ShaderCombination, Qt3DRender::QEffect *> effects_;
+
     private:
+    // Return effect for the specified shader combination, creating it if necessary
+    Qt3DRender::QEffect *effect(RenderableMaterial::ShaderCombination shaders);
+    // Return shader combination to use for data in the current view
+    RenderableMaterial::ShaderCombination dataShaders() const;
+    // Return the supplied shader combination adjusted for the current line render mode
+    RenderableMaterial::ShaderCombination lineShaders(RenderableMaterial::ShaderCombination shaders) const;
     // Create material for specified entity
     RenderableMaterial *createMaterial(
         Qt3DCore::QEntity *parent,
@@ -207,6 +487,38 @@ class MildredWidget : public QWidget
     // Add new data entity for supplied data
     Data1DEntity *addData1D(std::string_view tag);
 
+    /*
+     * Selection
+     */
+    private:
+    // Colour and size (in pixels) of highlighted selected points
+    QColor selectionColour_{255, 128, 0};
+    double selectionPointSize_{6.0};
+    // Region currently being dragged out (widget coordinates), and whether it is a lasso rather than a rectangle
+    QPolygon selectionRegion_;
+    bool lassoSelection_{false};
+    // Entity showing the region currently being dragged out
+    LineEntity *selectionRegionEntity_{nullptr};
+
+    private:
+    // Update the entity showing the region currently being dragged out
+    void updateSelectionRegionEntity();
+    // Select data points within the specified axis-space region
+    void select(const std::function<std::vector<int>(const Data1DEntity *)> &query);
+
+    public:
+    // Select data points within the specified rectangle (widget coordinates)
+    void selectRectangle(QRect rect);
+    // Select data points within the specified polygon (widget coordinates)
+    void selectPolygon(const QPolygon &polygon);
+    // Clear selection
+    void clearSelection();
+    // Return indices of selected data points, by data entity tag
+    std::vector<std::pair<std::string, std::vector<int>>> selection() const;
+
+    signals:
+    void selectionChanged();
+
     /*
      * Grouping
      */
@@ -218,4 +530,6 @@ class MildredWidget : public QWidget
     // Create new display group
     DisplayGroup *addDisplayGroup();
 };
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(MildredWidget::Invalidations)
 } // namespace Mildred
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "renderserver.h"
+#include <QApplication>
+#include <QCommandLineParser>
+
+int main(int argc, char *argv[])
+{
+    // Parse options before the application is created, since some (e.g. the program cache) must be set beforehand
+    QStringList arguments;
+    for (auto n = 0; n < argc; ++n)
+        arguments << QString::fromLocal8Bit(argv[n]);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Mildred batch plot rendering service");
+    parser.addHelpOption();
+    QCommandLineOption nameOption("name", "Name of the local socket to listen on (default = mildred-render)", "name",
+                                  "mildred-render");
+    parser.addOption(nameOption);
+    QCommandLineOption renderersOption("renderers", "Number of offscreen renderers to pipeline jobs across (default = 2)", "n",
+                                       "2");
+    parser.addOption(renderersOption);
+    QCommandLineOption programCacheOption("program-cache", "Enable the on-disk program binary cache, stored in <dir>", "dir");
+    parser.addOption(programCacheOption);
+    parser.parse(arguments);
+
+    if (parser.isSet("help"))
+    {
+        printf("%s", qPrintable(parser.helpText()));
+        return 0;
+    }
+
+    if (parser.isSet(programCacheOption))
+        Mildred::MildredWidget::enableProgramBinaryCache(parser.value(programCacheOption));
+
+    // Render servers typically have no display, so default to the offscreen platform
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+
+    MildredRender::RenderServer server(parser.value(renderersOption).toInt());
+    if (!server.listen(parser.value(nameOption)))
+    {
+        printf("Failed to listen on '%s'.\n", qPrintable(parser.value(nameOption)));
+        return 1;
+    }
+
+    printf("Listening on '%s'.\n", qPrintable(parser.value(nameOption)));
+
+    return app.exec();
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <QColor>
+#include <QDataStream>
+#include <QSize>
+#include <QString>
+#include <QSysInfo>
+#include <QtEndian>
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+/*
+ * mildred-render protocol
+ *
+ * Clients send a sequence of messages, each consisting of a quint32 payload length followed by the payload, written with a
+ * QDataStream (version Qt_6_0, little endian). Each request payload is a single PlotJob, and for each job the server replies
+ * (in the order jobs were received) with a message whose payload is a single PlotResult. Messages whose declared length
+ * exceeds maxMessageSize are rejected, and the sending client disconnected.
+ *
+ * Data arrays are written as a quint32 count (at most maxArraySize) followed by the raw little-endian IEEE-754 doubles, which
+ * are byte-swapped as necessary on big-endian hosts.
+ */
+
+namespace MildredRender
+{
+// Stream version used for all payloads
+constexpr auto streamVersion = QDataStream::Qt_6_0;
+// Maximum payload length of a single message, in bytes
+constexpr quint32 maxMessageSize = 1024 * 1024 * 1024;
+// Maximum number of values in a single data array
+constexpr quint32 maxArraySize = maxMessageSize / sizeof(double);
+// Maximum number of bytes passed to a single raw read or write (whose lengths are ints)
+constexpr qint64 maxRawBlockSize = 64 * 1024 * 1024;
+
+// Single data series within a plot
+struct PlotSeries
+{
+    // Line colour
+    QColor colour{Qt::black};
+    // Line and symbol styles (values of StyleFactory1D::Style and StyleFactory1D::SymbolStyle)
+    qint32 lineStyle{1}, symbolStyle{0};
+    // Data arrays
+    std::vector<double> x, values;
+    std::optional<std::vector<double>> errors;
+};
+
+// Axis settings for a plot
+struct PlotAxis
+{
+    // Axis title
+    QString title;
+    // Whether the axis is logarithmic
+    bool logarithmic{false};
+    // Explicit axis limits (otherwise set to show all data)
+    std::optional<std::pair<double, double>> limits;
+};
+
+// Plot job
+struct PlotJob
+{
+    // Client-supplied identifier, returned with the result
+    quint64 id{0};
+    // Image size (pixels) and resolution
+    QSize size{800, 600};
+    double dpi{96.0};
+    // Axes
+    PlotAxis xAxis, yAxis;
+    // Data series
+    std::vector<PlotSeries> series;
+};
+
+// Result of a plot job
+struct PlotResult
+{
+    // Identifier of the originating job
+    quint64 id{0};
+    // Error message, empty on success
+    QString error;
+    // PNG-encoded image
+    QByteArray png;
+};
+
+/*
+ * Serialisation
+ */
+
+inline QDataStream &operator<<(QDataStream &stream, const std::vector<double> &array)
+{
+    if (array.size() > maxArraySize)
+    {
+        stream.setStatus(QDataStream::WriteFailed);
+        return stream;
+    }
+
+    stream << quint32(array.size());
+    auto *data = reinterpret_cast<const char *>(array.data());
+    for (qint64 offset = 0, size = qint64(array.size() * sizeof(double)); offset < size; offset += maxRawBlockSize)
+    {
+        auto blockSize = int(std::min(maxRawBlockSize, size - offset));
+        if constexpr (QSysInfo::ByteOrder == QSysInfo::LittleEndian)
+            stream.writeRawData(data + offset, blockSize);
+        else
+        {
+            QByteArray block(blockSize, Qt::Uninitialized);
+            qToLittleEndian<double>(data + offset, blockSize / qsizetype(sizeof(double)), block.data());
+            stream.writeRawData(block.constData(), blockSize);
+        }
+    }
+    return stream;
+}
+
+inline QDataStream &operator>>(QDataStream &stream, std::vector<double> &array)
+{
+    quint32 count;
+    stream >> count;
+    // Guard against malformed counts before allocating
+    if (stream.status() != QDataStream::Ok || count > maxArraySize ||
+        stream.device()->bytesAvailable() < qint64(count) * qint64(sizeof(double)))
+    {
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return stream;
+    }
+    array.resize(count);
+    auto *data = reinterpret_cast<char *>(array.data());
+    for (qint64 offset = 0, size = qint64(count) * qint64(sizeof(double)); offset < size; offset += maxRawBlockSize)
+    {
+        auto blockSize = int(std::min(maxRawBlockSize, size - offset));
+        if (stream.readRawData(data + offset, blockSize) != blockSize)
+        {
+            stream.setStatus(QDataStream::ReadPastEnd);
+            return stream;
+        }
+        if constexpr (QSysInfo::ByteOrder != QSysInfo::LittleEndian)
+            qFromLittleEndian<double>(data + offset, blockSize / qsizetype(sizeof(double)), data + offset);
+    }
+    return stream;
+}
+
+inline QDataStream &operator<<(QDataStream &stream, const PlotSeries &series)
+{
+    stream << series.colour << series.lineStyle << series.symbolStyle << series.x << series.values << series.errors.has_value();
+    if (series.errors)
+        stream << *series.errors;
+    return stream;
+}
+
+inline QDataStream &operator>>(QDataStream &stream, PlotSeries &series)
+{
+    bool hasErrors;
+    stream >> series.colour >> series.lineStyle >> series.symbolStyle >> series.x >> series.values >> hasErrors;
+    if (hasErrors)
+        stream >> series.errors.emplace();
+    else
+        series.errors = std::nullopt;
+    return stream;
+}
+
+inline QDataStream &operator<<(QDataStream &stream, const PlotAxis &axis)
+{
+    stream << axis.title << axis.logarithmic << axis.limits.has_value();
+    if (axis.limits)
+        stream << axis.limits->first << axis.limits->second;
+    return stream;
+}
+
+inline QDataStream &operator>>(QDataStream &stream, PlotAxis &axis)
+{
+    bool hasLimits;
+    stream >> axis.title >> axis.logarithmic >> hasLimits;
+    if (hasLimits)
+    {
+        double minimum, maximum;
+        stream >> minimum >> maximum;
+        axis.limits = {minimum, maximum};
+    }
+    else
+        axis.limits = std::nullopt;
+    return stream;
+}
+
+inline QDataStream &operator<<(QDataStream &stream, const PlotJob &job)
+{
+    stream << job.id << job.size << job.dpi << job.xAxis << job.yAxis << quint32(job.series.size());
+    for (auto &series : job.series)
+        stream << series;
+    return stream;
+}
+
+inline QDataStream &operator>>(QDataStream &stream, PlotJob &job)
+{
+    quint32 nSeries;
+    stream >> job.id >> job.size >> job.dpi >> job.xAxis >> job.yAxis >> nSeries;
+    job.series.clear();
+    for (quint32 n = 0; n < nSeries && stream.status() == QDataStream::Ok; ++n)
+        stream >> job.series.emplace_back();
+    return stream;
+}
+
+inline QDataStream &operator<<(QDataStream &stream, const PlotResult &result)
+{
+    stream << result.id << result.error << result.png;
+    return stream;
+}
+
+inline QDataStream &operator>>(QDataStream &stream, PlotResult &result)
+{
+    stream >> result.id >> result.error >> result.png;
+    return stream;
+}
+} // namespace MildredRender
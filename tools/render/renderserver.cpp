@@ -0,0 +1,244 @@
+#include "renderserver.h"
+#include <QBuffer>
+#include <QtEndian>
+
+using namespace MildredRender;
+
+RenderServer::RenderServer(int nRenderers, QObject *parent) : QObject(parent)
+{
+    renderers_.resize(std::max(1, nRenderers));
+    for (auto &renderer : renderers_)
+        renderer.widget = std::make_unique<Mildred::MildredWidget>();
+
+    connect(&server_, SIGNAL(newConnection()), this, SLOT(acceptConnections()));
+}
+
+/*
+ * Connections
+ */
+
+//! Read any complete jobs available on the specified socket
+/*!
+ * Append available data from @param socket to its receive buffer, and queue every complete job message found therein. Clients
+ * declaring a message longer than maxMessageSize are disconnected, so that the buffer can't grow without bound.
+ */
+void RenderServer::readJobs(QLocalSocket *socket)
+{
+    auto &buffer = receiveBuffers_[socket];
+    buffer.append(socket->readAll());
+
+    while (buffer.size() >= qsizetype(sizeof(quint32)))
+    {
+        auto length = qFromLittleEndian<quint32>(buffer.constData());
+        if (length > maxMessageSize)
+        {
+            printf("Client declared a message of %u bytes (maximum %u), so will be disconnected.\n", length, maxMessageSize);
+            receiveBuffers_.erase(socket);
+            socket->abort();
+            break;
+        }
+        if (buffer.size() < qsizetype(sizeof(quint32) + length))
+            break;
+
+        QByteArray payload = buffer.mid(sizeof(quint32), length);
+        buffer.remove(0, sizeof(quint32) + length);
+
+        QDataStream stream(payload);
+        stream.setVersion(streamVersion);
+        stream.setByteOrder(QDataStream::LittleEndian);
+
+        auto &pending = pendingJobs_.emplace_back();
+        pending.socket = socket;
+        stream >> pending.job;
+        if (stream.status() != QDataStream::Ok)
+            pending.error = "Malformed job.";
+        else
+            pending.error = validate(pending.job);
+    }
+
+    dispatch();
+}
+
+//! Send result to the specified socket
+void RenderServer::sendResult(QLocalSocket *socket, const PlotResult &result)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(streamVersion);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream << result;
+
+    QByteArray header(sizeof(quint32), 0);
+    qToLittleEndian<quint32>(payload.size(), header.data());
+    socket->write(header);
+    socket->write(payload);
+}
+
+//! Accept new connections
+void RenderServer::acceptConnections()
+{
+    while (auto *socket = server_.nextPendingConnection())
+    {
+        connect(socket, &QLocalSocket::readyRead, this, [this, socket]() { readJobs(socket); });
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QObject::destroyed, this, [this, socket]() { receiveBuffers_.erase(socket); });
+    }
+}
+
+//! Start listening on the named local socket
+/*!
+ * Listen for connections on the local socket @param name, removing any stale socket of the same name left by a previous
+ * instance.
+ */
+bool RenderServer::listen(const QString &name)
+{
+    QLocalServer::removeServer(name);
+    return server_.listen(name);
+}
+
+/*
+ * Rendering
+ */
+
+//! Check job for validity, returning an error message if it cannot be rendered
+QString RenderServer::validate(const PlotJob &job)
+{
+    if (job.size.isEmpty() || job.size.width() > 16384 || job.size.height() > 16384)
+        return QString("Invalid image size %1x%2.").arg(job.size.width()).arg(job.size.height());
+    if (job.dpi <= 0.0)
+        return QString("Invalid resolution %1.").arg(job.dpi);
+
+    for (auto n = 0; n < int(job.series.size()); ++n)
+    {
+        auto &series = job.series[n];
+        if (series.x.size() != series.values.size() || (series.errors && series.errors->size() != series.values.size()))
+            return QString("Array sizes for series %1 do not match.").arg(n);
+        if (series.lineStyle < int(Mildred::StyleFactory1D::Style::None) ||
+            series.lineStyle > int(Mildred::StyleFactory1D::Style::Line))
+            return QString("Invalid line style for series %1.").arg(n);
+        if (series.symbolStyle < int(Mildred::StyleFactory1D::SymbolStyle::None) ||
+            series.symbolStyle > int(Mildred::StyleFactory1D::SymbolStyle::Triangle))
+            return QString("Invalid symbol style for series %1.").arg(n);
+    }
+
+    return {};
+}
+
+//! Set up renderer for the specified job
+/*!
+ * Set the data and axes of the @param renderer's widget from the supplied @param job. Data entities are reused between jobs,
+ * with any not required by the current job being disabled.
+ */
+void RenderServer::apply(Renderer &renderer, const PlotJob &job)
+{
+    auto &widget = *renderer.widget;
+
+    // Create additional entities if required
+    while (renderer.entities.size() < job.series.size())
+        renderer.entities.push_back(widget.addData1D(QString("Series%1").arg(renderer.entities.size()).toStdString()));
+
+    for (auto n = 0; n < int(renderer.entities.size()); ++n)
+    {
+        auto *entity = renderer.entities[n];
+        if (n >= int(job.series.size()))
+        {
+            entity->setEnabled(false);
+            continue;
+        }
+
+        auto &series = job.series[n];
+        entity->setEnabled(true);
+        entity->colour().set(series.colour);
+        entity->setLineStyle(Mildred::StyleFactory1D::Style(series.lineStyle));
+        entity->setSymbolStyle(Mildred::StyleFactory1D::SymbolStyle(series.symbolStyle));
+        entity->setData(series.x, series.values, series.errors);
+    }
+
+    // Set axes
+    widget.setXAxisTitle(job.xAxis.title);
+    widget.setYAxisTitle(job.yAxis.title);
+    widget.xAxis()->setLogarithmic(job.xAxis.logarithmic);
+    widget.yAxis()->setLogarithmic(job.yAxis.logarithmic);
+    if (!job.xAxis.limits || !job.yAxis.limits)
+        widget.showAllData();
+    if (job.xAxis.limits)
+        widget.xAxis()->setLimits(job.xAxis.limits->first, job.xAxis.limits->second);
+    if (job.yAxis.limits)
+        widget.yAxis()->setLimits(job.yAxis.limits->first, job.yAxis.limits->second);
+}
+
+//! Dispatch pending jobs to idle renderers
+/*!
+ * Jobs are taken from the pending queue while an idle renderer is available. Rendering happens asynchronously on the Qt3D
+ * render thread, so data for the next job is uploaded to another renderer while the current job is being drawn.
+ */
+void RenderServer::dispatch()
+{
+    while (!pendingJobs_.empty())
+    {
+        auto &pending = pendingJobs_.front();
+
+        auto dispatched = dispatchedJobs_.emplace_back(std::make_shared<DispatchedJob>());
+        dispatched->socket = pending.socket;
+        dispatched->result.id = pending.job.id;
+
+        // Jobs with errors (or whose client has gone) complete immediately
+        if (!pending.error.isEmpty() || !pending.socket)
+        {
+            dispatched->result.error = pending.error;
+            dispatched->complete = true;
+            pendingJobs_.pop_front();
+            continue;
+        }
+
+        auto it = std::find_if(renderers_.begin(), renderers_.end(), [](const auto &r) { return !r.busy; });
+        if (it == renderers_.end())
+        {
+            dispatchedJobs_.pop_back();
+            break;
+        }
+
+        auto *renderer = &(*it);
+        auto job = std::move(pending.job);
+        pendingJobs_.pop_front();
+
+        apply(*renderer, job);
+        auto *reply = renderer->widget->requestImage(job.size, job.dpi);
+        renderer->busy = true;
+
+        connect(reply, &Qt3DRender::QRenderCaptureReply::completed, this, [this, renderer, reply, dispatched, dpi = job.dpi]() {
+            auto image = reply->image();
+            image.setDotsPerMeterX(qRound(dpi / 0.0254));
+            image.setDotsPerMeterY(qRound(dpi / 0.0254));
+            QBuffer buffer(&dispatched->result.png);
+            buffer.open(QIODevice::WriteOnly);
+            if (!image.save(&buffer, "PNG"))
+                dispatched->result.error = "Failed to encode image.";
+            dispatched->complete = true;
+            ++nJobsCompleted_;
+
+            reply->deleteLater();
+            renderer->busy = false;
+
+            flushResults();
+            dispatch();
+        });
+    }
+
+    flushResults();
+}
+
+//! Send results of completed jobs, in order of receipt
+void RenderServer::flushResults()
+{
+    while (!dispatchedJobs_.empty() && dispatchedJobs_.front()->complete)
+    {
+        auto &dispatched = dispatchedJobs_.front();
+        if (dispatched->socket)
+            sendResult(dispatched->socket, dispatched->result);
+        dispatchedJobs_.pop_front();
+    }
+}
+
+//! Return number of jobs completed
+quint64 RenderServer::nJobsCompleted() const { return nJobsCompleted_; }
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "protocol.h"
+#include "widget.h"
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+#include <deque>
+#include <map>
+#include <memory>
+
+namespace MildredRender
+{
+//! RenderServer accepts plot jobs over a local socket and returns rendered images.
+/*!
+ * RenderServer listens on a QLocalServer for PlotJob messages (see protocol.h), renders each to a PNG using a small pool of
+ * offscreen MildredWidgets, and returns a PlotResult for each job in the order jobs were received.
+ *
+ * The widgets (and their Qt3D engines, shader programs, and glyph meshes) persist for the lifetime of the server. Jobs are
+ * pipelined across the pool, so that data for one job is uploaded while the previous job is being rendered.
+ */
+class RenderServer : public QObject
+{
+    Q_OBJECT
+
+    public:
+    explicit RenderServer(int nRenderers = 2, QObject *parent = nullptr);
+    ~RenderServer() override = default;
+
+    /*
+     * Connections
+     */
+    private:
+    // Local server
+    QLocalServer server_;
+    // Partially-received messages for each connection
+    std::map<QLocalSocket *, QByteArray> receiveBuffers_;
+
+    private:
+    // Read any complete jobs available on the specified socket
+    void readJobs(QLocalSocket *socket);
+    // Send result to the specified socket
+    void sendResult(QLocalSocket *socket, const PlotResult &result);
+
+    private slots:
+    // Accept new connections
+    void acceptConnections();
+
+    public:
+    // Start listening on the named local socket
+    bool listen(const QString &name);
+
+    /*
+     * Rendering
+     */
+    private:
+    // Offscreen renderer and its reusable data entities
+    struct Renderer
+    {
+        std::unique_ptr<Mildred::MildredWidget> widget;
+        std::vector<Mildred::Data1DEntity *> entities;
+        bool busy{false};
+    };
+    // Job waiting for a renderer
+    struct PendingJob
+    {
+        QPointer<QLocalSocket> socket;
+        PlotJob job;
+        // Error found when decoding or validating the job
+        QString error;
+    };
+    // Job which has been dispatched, and its result
+    struct DispatchedJob
+    {
+        QPointer<QLocalSocket> socket;
+        PlotResult result;
+        bool complete{false};
+    };
+    // Renderer pool
+    std::vector<Renderer> renderers_;
+    // Jobs waiting for a renderer, in order of receipt
+    std::deque<PendingJob> pendingJobs_;
+    // Dispatched jobs, in order of receipt
+    std::deque<std::shared_ptr<DispatchedJob>> dispatchedJobs_;
+    // Number of jobs completed
+    quint64 nJobsCompleted_{0};
+
+    private:
+    // Check job for validity, returning an error message if it cannot be rendered
+    static QString validate(const PlotJob &job);
+    // Set up renderer for the specified job
+    static void apply(Renderer &renderer, const PlotJob &job);
+    // Dispatch pending jobs to idle renderers
+    void dispatch();
+    // Send results of completed jobs, in order of receipt
+    void flushResults();
+
+    public:
+    // Return number of jobs completed
+    quint64 nJobsCompleted() const;
+};
+} // namespace MildredRender